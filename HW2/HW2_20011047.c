@@ -22,34 +22,659 @@
        - dynamically allocating and freeing memory for the keys and locks
 
        at the end of the program, the user receives a printed list of matched keys and locks.
+
+       for big inputs the program can also match in parallel: the two sub-ranges left after each partition step
+       are pushed as tasks to a pool of worker threads which steal work from each other. command line usage:
+       - no arguments                       -> interactive mode, serial matching (as before)
+       - -t <threads>                       -> interactive mode, parallel matching with the given thread count
+       - --bench-parallel <N> [-t <threads>] [-c <cutoff>]
+                                            -> generates N random key/lock pairs and compares serial and parallel time
+       - --bench-partition <N> [--no-simd]  -> compares elements/sec of makePartition and makePartitionInt
+       - -i <file> [-o <file>] [--binary-output]
+                                            -> non-interactive mode, reads the keys and locks from a file, matches them
+                                               and writes the pairs to a file (or stdout if -o is missing or "-")
+       - --make-input <N> <file> [--key-width 4|8|16]
+                                            -> writes N random key/lock pairs to a binary input file, with int keys
+                                               or with 64-bit or 128-bit keys
+       - -s <seed>                          -> seeds the pivot generator, the same seed gives the same serial run
+       - --external <file> [-o <file>] [--binary-output] [--memory-limit <MB>] [--temp-dir <dir>]
+                                            -> out-of-core mode for binary inputs bigger than the memory
+       - --bench <N> [--rounds <R>] [--dist <list>] [--format text|csv|json]
+                                            -> runs matchKeysAndLocksInt R times on random, sorted, reversed and
+                                               duplicates inputs (or the comma separated list given with --dist) and
+                                               reports the time, comparisons, swaps, depth and partition balance
+       - --bench-keys <N>                   -> matches N random pairs with every key type of DEFINE_KEY_MATCHER
+
+       the input file of -i is either binary or text. the binary file is a 16 byte header ("LKB1", the key width in
+       bytes, 3 zero bytes and N as a 64-bit integer) followed by the N keys and the N locks in the byte order of the
+       machine; it is memory-mapped privately and matched in place without copying. the key width is 4 (int, a 0 is
+       read as 4 too), 8 (int64_t) or 16 (Key128: the high and then the low 64 bits). a text file holds N and then
+       the int keys and the locks separated by any whitespace, it is mapped too and read with a small integer parser.
+
+       the matcher partitions with makePartitionInt: a branch-free three-way partition that works on blocks of
+       elements (BlockQuicksort style). on x86 CPUs with AVX2 the blocks are split with vector compares and a
+       compress-store made from a permutation table, the CPU is checked at runtime so the same binary runs everywhere.
+
+       the matcher is introspective: the pivots come from a small seedable generator that every thread owns (instead
+       of the global rand()), big ranges use the median of several sampled keys, only the smaller side is recursed
+       (so the stack stays O(log N)) and after 2*log2(N) levels the range is heap sorted, which bounds the work by
+       O(N log N) even for adversarial or heavily duplicated inputs.
+
+       the out-of-core mode uses the same idea on files: sampled pivot keys split the locks stream into buckets, the
+       locks equal to the pivots split the keys stream the same way, so bucket i of the keys and bucket i of the locks
+       hold the same values. the buckets are written to temporary files in one pass and every bucket that fits in the
+       memory limit is matched in memory, the bigger ones are split again. the bytes read and written and the peak
+       resident memory are printed to stderr at the end.
+
+       the matcher is written once, in DEFINE_KEY_MATCHER, for a key type and its comparator macros with size_t
+       indices; the comparator is expanded into the partition loop, so there is no function pointer in it. it is
+       generated for int (matchKeysAndLocksInt, used by every mode, its block kernel is the scalar or the AVX2 one),
+       64-bit integers, 128-bit ids (Key128) and fixed-length byte strings (KeyBytes, KEY_BYTES_LENGTH bytes,
+       compared like memcmp), e.g. matchKeysAndLocksU128(keys, locks, n). the binary files of -i can hold 64-bit and
+       128-bit keys, they are matched serially; the parallel and the out-of-core modes work on int keys. byte string
+       keys are only reachable from code.
 */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAVE_AVX2_KERNEL 1
+#endif
+
+#define PARALLEL_CUTOFF 16384 // ranges smaller than this are matched serially by one worker
+#define PARTITION_BLOCK 64 // number of elements scanned at once by the block partition
+#define BINARY_MAGIC "LKB1" // the first 4 bytes of a binary input file
+#define BINARY_HEADER_SIZE 16
+#define OUTPUT_BUFFER_SIZE (1 << 20) // the pairs are written in chunks of this size
+#define MEDIAN_OF_3_SIZE 64 // ranges at least this big use the median of 3 sampled keys as the pivot
+#define MEDIAN_OF_9_SIZE 4096 // ranges at least this big use the median of 9 sampled keys
+#define EXTERNAL_MAX_BUCKETS 64 // the number of buckets a range is split into in one pass, at most
+#define EXTERNAL_SAMPLES_PER_PIVOT 8 // the pivots are every 8th of the sorted sampled keys
+#define EXTERNAL_FILE_BUFFER (64 * 1024) // the stdio buffer of every bucket file
+#define EXTERNAL_CHUNK 65536 // the number of integers read from a stream at once
+#define BALANCE_BINS 10 // the histogram of min(left, right) / (n - 1) has bins of width 0.05
+#define BALANCE_MIN_SIZE 16 // smaller ranges are not added to the histogram, they would fill the first bin
+#ifndef KEY_BYTES_LENGTH
+#define KEY_BYTES_LENGTH 16 // the length of a KeyBytes key, it can be changed with -DKEY_BYTES_LENGTH=<n>
+#endif
+
+// the n keys and locks starting at index low, waiting to be matched
+typedef struct {
+    size_t low;
+    size_t n;
+    int depthBudget; // the number of partition levels left before the range is heap sorted
+} MatchTask;
+
+// the state of a splitmix64 generator, every thread has its own one
+typedef struct {
+    uint64_t state;
+} MatchRng;
+
+// every worker owns one deque: it pushes and pops at the bottom, other workers steal from the top
+typedef struct {
+    MatchTask *tasks;
+    int capacity;
+    int top;
+    int bottom;
+    pthread_mutex_t lock;
+} TaskDeque;
+
+// the shared state of one parallel matching run
+typedef struct {
+    int *keys;
+    int *locks;
+    TaskDeque *deques;
+    int threadCount;
+    size_t cutoff;
+    atomic_int pendingTasks; // tasks pushed but not finished yet, the workers stop when it reaches 0
+} MatchPool;
+
+// the arguments given to every worker thread
+typedef struct {
+    MatchPool *pool;
+    int id;
+    MatchRng rng;
+} WorkerArgs;
+
+// the keys and locks read from an input file, for a binary file they point into the mapping
+typedef struct {
+    void *mapping; // NULL if the arrays were allocated with malloc
+    size_t mappingLength;
+    void *keys; // int, int64_t or Key128 elements, see keyWidth
+    void *locks;
+    size_t N;
+    int keyWidth; // the size of one key in bytes: 4, 8 or 16
+} PairInput;
+
+// the counters of one instrumented matching run, collected only while activeStats points to them
+typedef struct {
+    unsigned long long comparisons; // element-pivot comparisons in the partitions and the heap sorts
+    unsigned long long swaps; // element exchanges done by the partition kernel and the heap sorts
+    unsigned long long partitions; // the number of partition steps (one step partitions both arrays)
+    unsigned long long heapSorts; // the number of ranges given to the heap sort fallback
+    int initialBudget;
+    int maxDepth;
+    unsigned long long balance[BALANCE_BINS];
+} MatchStats;
+
+// a 128-bit id, compared as one unsigned number
+typedef struct {
+    uint64_t high;
+    uint64_t low;
+} Key128;
+
+// a fixed-length byte string key
+typedef struct {
+    unsigned char bytes[KEY_BYTES_LENGTH];
+} KeyBytes;
+
+// the input distributions of the benchmark
+typedef enum {
+    DIST_RANDOM,
+    DIST_SORTED,
+    DIST_REVERSED,
+    DIST_DUPLICATES
+} PairDistribution;
+
+// a buffered writer that sends the output to the file in big chunks
+typedef struct {
+    FILE *file;
+    char *buffer;
+    size_t used;
+    unsigned long long written; // the number of bytes given to the buffer
+} OutputBuffer;
+
+// one range of the out-of-core matcher: n keys and n locks stored at an offset of two files
+typedef struct {
+    FILE *keysFile;
+    off_t keysOffset;
+    FILE *locksFile;
+    off_t locksOffset;
+    long long n;
+    int splitByMiddle; // 1 if the sampled pivots could not split this range, then it is split at the middle value
+    int minValue;
+    int maxValue;
+} ExternalRange;
+
+// the shared state of an out-of-core run
+typedef struct {
+    size_t memoryLimit; // the biggest range matched in memory, in bytes of keys and locks
+    const char *tempDir;
+    int binary;
+    OutputBuffer out;
+    FILE *locksCopy; // binary output: the matched locks wait here until all the keys are written
+    MatchRng rng;
+    unsigned long long bytesRead;
+    unsigned long long bytesWritten; // temporary files only, the output is counted by the OutputBuffer
+    long long bucketsMatched;
+    int deepestLevel;
+} ExternalContext;
 
 
 // Function prototypes, they are explained in detailed below
-void matchKeysAndLocks(int keys[], int locks[], int low, int high);
 int makePartition(int arr[], int low, int high, int pivot);
-void getInputFromUser(int *N, int **keys, int **locks);
+void getInputFromUser(size_t *N, int **keys, int **locks);
 void makeSwap(int *a, int *b); // Swap function
+void setMatcherSeed(uint64_t seed);
+void initRng(MatchRng *rng, uint64_t seed);
+uint64_t nextRandom(MatchRng *rng);
+int randomIndex(MatchRng *rng, int low, int high);
+int depthBudgetFor(size_t n);
+size_t randomOffset(MatchRng *rng, size_t n);
+void benchmarkKeyTypes(size_t n);
+void matchKeysAndLocksParallel(int keys[], int locks[], size_t N, int threadCount, size_t cutoff);
+void pushTask(TaskDeque *deque, MatchTask task);
+int popTask(TaskDeque *deque, MatchTask *task);
+int stealTask(MatchPool *pool, int thiefId, MatchRng *rng, MatchTask *task);
+void runMatchTask(MatchPool *pool, int id, MatchRng *rng, MatchTask task);
+void *matchWorker(void *arg);
+double getTimeInSeconds(void);
+void generateRandomPairs(size_t N, int **keys, int **locks, unsigned int seed);
+int isMatched(int keys[], int locks[], size_t N);
+void benchmarkParallel(size_t N, int threadCount, size_t cutoff);
+size_t partitionBlockScalar(int arr[], size_t n, int pivot, int inclusive);
+void selectPartitionKernel(int allowSimd);
+void benchmarkPartition(int N, int allowSimd);
+#ifdef HAVE_AVX2_KERNEL
+size_t partitionBlockAVX2(int arr[], size_t n, int pivot, int inclusive);
+#endif
+int readPairsFromFile(const char *path, PairInput *input);
+void freePairInput(PairInput *input);
+int parseNextInt(const char **cursor, const char *end, long long *value);
+void writeBytes(OutputBuffer *out, const void *data, size_t length);
+void writeInt(OutputBuffer *out, long long value);
+void writeKey(OutputBuffer *out, const void *key, int keyWidth);
+void writeBinaryHeader(OutputBuffer *out, size_t N, int keyWidth);
+int writePairsToFile(const char *path, const void *keys, const void *locks, size_t N, int keyWidth, int binary);
+int writeBinaryInput(const char *path, int keys[], int locks[], size_t N);
+int writeWideInput(const char *path, size_t N, int keyWidth, uint64_t seed);
+int openOutputBuffer(OutputBuffer *out, const char *path);
+void writePairLines(OutputBuffer *out, const void *keys, const void *locks, size_t n, int keyWidth);
+int closeOutputBuffer(OutputBuffer *out, const char *path);
+int matchExternal(const char *inputPath, const char *outputPath, int binary, size_t memoryLimit, const char *tempDir);
+int matchExternalRange(ExternalContext *ctx, ExternalRange range, int level);
+FILE *openTempFile(ExternalContext *ctx);
+size_t readRangeInts(ExternalContext *ctx, FILE *file, int *buffer, size_t count);
+void emitMatchedPairs(ExternalContext *ctx, int keys[], int locks[], size_t n);
+void generatePairs(size_t N, PairDistribution distribution, int **keys, int **locks, unsigned int seed);
+int runBenchmark(size_t N, int rounds, const char *distributions, const char *format);
+
+// the seed of the pivot generators, set once in main before any matching
+static uint64_t matcherSeed = 0;
+
+// the counters of the running benchmark, NULL when nothing is measured
+static MatchStats *activeStats = NULL;
+
+static const char *distributionNames[] = {"random", "sorted", "reversed", "duplicates"};
+
+// the kernel used by makePartitionInt, selectPartitionKernel sets it to the AVX2 one when the CPU supports it
+static size_t (*partitionKernel)(int arr[], size_t n, int pivot, int inclusive) = partitionBlockScalar;
+
+// the comparators of the key types, they must not branch so the block partition stays branch-free
+#define LESS_SCALAR(a, b) ((a) < (b))
+#define EQUAL_SCALAR(a, b) ((a) == (b))
+#define LESS_128(a, b) (((a).high < (b).high) | (((a).high == (b).high) & ((a).low < (b).low)))
+#define EQUAL_128(a, b) (((a).high == (b).high) & ((a).low == (b).low))
+#define LESS_BYTES(a, b) (memcmp((a).bytes, (b).bytes, KEY_BYTES_LENGTH) < 0)
+#define EQUAL_BYTES(a, b) (memcmp((a).bytes, (b).bytes, KEY_BYTES_LENGTH) == 0)
+
+/*
+@brief this function adds one partition step to the counters of the running benchmark: the balance of the split and the deepest level reached.
+@param n -> the length of the partitioned range
+@param left -> the number of elements less than the pivot
+@param right -> the number of elements greater than the pivot
+@param depthBudget -> the depth budget left after this step
+@return
+*/
+static void recordPartition(size_t n, size_t left, size_t right, int depthBudget) {
+    size_t smaller = left < right ? left : right;
+    int bin = (int)((double)smaller / (n - 1) * 2 * BALANCE_BINS);
+    int depth = activeStats->initialBudget - depthBudget;
+
+    activeStats->partitions++;
+    if (n >= BALANCE_MIN_SIZE) activeStats->balance[bin < BALANCE_BINS ? bin : BALANCE_BINS - 1]++;
+    if (depth > activeStats->maxDepth) activeStats->maxDepth = depth;
+}
+
+/*
+@brief this macro generates the matcher of one key type: a three-way block partition, median-of-k pivots, recursion on the smaller side and a heap sort fallback after depthBudgetFor(n) levels. every range is a pointer and a size_t length, and LESS / EQUAL are macros, so the compiler inlines the comparison into the partition loop. the counters of activeStats are updated when it is set. the generated public function is:
+       void matchKeysAndLocks<SUFFIX>(TYPE keys[], TYPE locks[], size_t n)
+       the int matcher of the interactive, file, parallel and out-of-core modes is matchKeysAndLocksInt, the other types are used by the binary files with wider keys and by --bench-keys.
+@param SUFFIX -> the end of the generated function names
+@param TYPE -> the key type, it is copied by value
+@param LESS -> a macro LESS(a, b) that is 1 if a < b, 0 otherwise
+@param EQUAL -> a macro EQUAL(a, b) that is 1 if a == b, 0 otherwise
+@param BLOCK -> the block kernel used by the partition, size_t BLOCK(TYPE arr[], size_t n, const TYPE *pivot, int inclusive); it is partitionBlock<SUFFIX> (generated here) for the types without a vector kernel
+*/
+#define DEFINE_KEY_MATCHER(SUFFIX, TYPE, LESS, EQUAL, BLOCK)                                                           \
+static inline void swapKeys##SUFFIX(TYPE *a, TYPE *b) {                                                                \
+    TYPE temp = *a;                                                                                                    \
+    *a = *b;                                                                                                           \
+    *b = temp;                                                                                                         \
+}                                                                                                                      \
+static inline int goesLeft##SUFFIX(const TYPE *x, const TYPE *pivot, int inclusive) {                                  \
+    return LESS(*x, *pivot) | (EQUAL(*x, *pivot) & inclusive);                                                         \
+}                                                                                                                      \
+/* the portable block kernel: moves the elements that go left (less than the pivot, or also equal if inclusive */      \
+/* is 1) to the start. like BlockQuicksort it writes the offsets of the misplaced elements of a left and a right */    \
+/* block without any branch, then swaps them in pairs; the rest is finished with a branch-free Lomuto loop */          \
+static inline size_t partitionBlock##SUFFIX(TYPE arr[], size_t n, const TYPE *pivot, int inclusive) {                  \
+    unsigned char offsetsLeft[PARTITION_BLOCK], offsetsRight[PARTITION_BLOCK];                                         \
+    size_t numLeft = 0, numRight = 0, startLeft = 0, startRight = 0, num, i, k;                                        \
+    size_t l = 0, r = n; /* the unfinished part is arr[l..r-1] */                                                      \
+    unsigned long long swaps = 0;                                                                                      \
+    while (r - l > 2 * PARTITION_BLOCK) {                                                                              \
+        if (numLeft == 0) {                                                                                            \
+            startLeft = 0;                                                                                             \
+            for (i = 0; i < PARTITION_BLOCK; i++) {                                                                    \
+                offsetsLeft[numLeft] = (unsigned char)i;                                                               \
+                numLeft += !goesLeft##SUFFIX(&arr[l + i], pivot, inclusive);                                           \
+            }                                                                                                          \
+        }                                                                                                              \
+        if (numRight == 0) {                                                                                           \
+            startRight = 0;                                                                                            \
+            for (i = 0; i < PARTITION_BLOCK; i++) {                                                                    \
+                offsetsRight[numRight] = (unsigned char)i;                                                             \
+                numRight += goesLeft##SUFFIX(&arr[r - 1 - i], pivot, inclusive);                                       \
+            }                                                                                                          \
+        }                                                                                                              \
+        num = numLeft < numRight ? numLeft : numRight;                                                                 \
+        for (k = 0; k < num; k++)                                                                                      \
+            swapKeys##SUFFIX(&arr[l + offsetsLeft[startLeft + k]], &arr[r - 1 - offsetsRight[startRight + k]]);        \
+        swaps += num;                                                                                                  \
+        numLeft -= num;                                                                                                \
+        numRight -= num;                                                                                               \
+        startLeft += num;                                                                                              \
+        startRight += num;                                                                                             \
+        if (numLeft == 0) l += PARTITION_BLOCK;                                                                        \
+        if (numRight == 0) r -= PARTITION_BLOCK;                                                                       \
+    }                                                                                                                  \
+    swaps += r - l; /* the Lomuto loop exchanges once per element */                                                   \
+    for (i = l; i < r; i++) {                                                                                          \
+        int left = goesLeft##SUFFIX(&arr[i], pivot, inclusive);                                                        \
+        swapKeys##SUFFIX(&arr[i], &arr[l]);                                                                            \
+        l += (size_t)left;                                                                                             \
+    }                                                                                                                  \
+    if (activeStats != NULL) activeStats->swaps += swaps;                                                              \
+    return l;                                                                                                          \
+}                                                                                                                      \
+/* three-way partition with BLOCK, returns the first index of the pivot and writes the end of the equal run */         \
+static inline size_t makePartition##SUFFIX(TYPE arr[], size_t n, TYPE pivot, size_t *equalEnd) {                       \
+    size_t lessEnd = BLOCK(arr, n, &pivot, 0);                                                                         \
+    *equalEnd = lessEnd + BLOCK(arr + lessEnd, n - lessEnd, &pivot, 1);                                                \
+    if (activeStats != NULL) activeStats->comparisons += (unsigned long long)n + (n - lessEnd);                        \
+    return lessEnd;                                                                                                    \
+}                                                                                                                      \
+/* one random key for small ranges, the median of 3 or 9 random keys for the bigger ones */                            \
+static TYPE choosePivot##SUFFIX(const TYPE keys[], size_t n, MatchRng *rng) {                                          \
+    TYPE samples[9];                                                                                                   \
+    int sampleCount = n >= MEDIAN_OF_9_SIZE ? 9 : n >= MEDIAN_OF_3_SIZE ? 3 : 1;                                       \
+    int i, j;                                                                                                          \
+    for (i = 0; i < sampleCount; i++) {                                                                                \
+        TYPE value = keys[randomOffset(rng, n)];                                                                       \
+        for (j = i; j > 0 && LESS(value, samples[j - 1]); j--)                                                         \
+            samples[j] = samples[j - 1];                                                                               \
+        samples[j] = value;                                                                                            \
+    }                                                                                                                  \
+    return samples[sampleCount / 2];                                                                                   \
+}                                                                                                                      \
+/* the O(n log n) fallback of the matcher */                                                                           \
+static void heapSort##SUFFIX(TYPE heap[], size_t n) {                                                                  \
+    size_t start = n / 2, end = n, root, child;                                                                        \
+    unsigned long long comparisons = 0, swaps = 0;                                                                     \
+    while (end > 1) {                                                                                                  \
+        if (start > 0) {                                                                                               \
+            root = --start; /* building the heap */                                                                    \
+        } else {                                                                                                       \
+            swapKeys##SUFFIX(&heap[0], &heap[--end]); /* moving the biggest element to the end */                      \
+            swaps++;                                                                                                   \
+            root = 0;                                                                                                  \
+        }                                                                                                              \
+        while ((child = 2 * root + 1) < end) {                                                                         \
+            if (child + 1 < end && LESS(heap[child], heap[child + 1])) child++;                                        \
+            comparisons += 2;                                                                                          \
+            if (!LESS(heap[root], heap[child])) break;                                                                 \
+            swapKeys##SUFFIX(&heap[root], &heap[child]);                                                               \
+            swaps++;                                                                                                   \
+            root = child;                                                                                              \
+        }                                                                                                              \
+    }                                                                                                                  \
+    if (activeStats != NULL) {                                                                                         \
+        activeStats->comparisons += comparisons;                                                                       \
+        activeStats->swaps += swaps;                                                                                   \
+    }                                                                                                                  \
+}                                                                                                                      \
+/* partitions the locks with a pivot key and the keys with the matching lock, recurses into the smaller side */        \
+/* and loops on the bigger one; when the depth budget is used up both arrays are heap sorted, they hold the */         \
+/* same values, so sorting them also matches them */                                                                   \
+static void matchRange##SUFFIX(TYPE keys[], TYPE locks[], size_t n, int depthBudget, MatchRng *rng) {                  \
+    while (n > 1) {                                                                                                    \
+        size_t pivotIndex, equalEnd, keysEqualEnd;                                                                     \
+        if (depthBudget-- <= 0) {                                                                                      \
+            if (activeStats != NULL) activeStats->heapSorts++;                                                         \
+            heapSort##SUFFIX(keys, n);                                                                                 \
+            heapSort##SUFFIX(locks, n);                                                                                \
+            return;                                                                                                    \
+        }                                                                                                              \
+        pivotIndex = makePartition##SUFFIX(locks, n, choosePivot##SUFFIX(keys, n, rng), &equalEnd);                    \
+        makePartition##SUFFIX(keys, n, locks[pivotIndex], &keysEqualEnd);                                              \
+        if (activeStats != NULL) recordPartition(n, pivotIndex, n - equalEnd, depthBudget);                            \
+        if (pivotIndex < n - equalEnd) {                                                                               \
+            matchRange##SUFFIX(keys, locks, pivotIndex, depthBudget, rng);                                             \
+            keys += equalEnd;                                                                                          \
+            locks += equalEnd;                                                                                         \
+            n -= equalEnd;                                                                                             \
+        } else {                                                                                                       \
+            matchRange##SUFFIX(keys + equalEnd, locks + equalEnd, n - equalEnd, depthBudget, rng);                     \
+            n = pivotIndex;                                                                                            \
+        }                                                                                                              \
+    }                                                                                                                  \
+}                                                                                                                      \
+void matchKeysAndLocks##SUFFIX(TYPE keys[], TYPE locks[], size_t n) {                                                  \
+    MatchRng rng;                                                                                                      \
+    initRng(&rng, matcherSeed);                                                                                        \
+    if (activeStats != NULL) activeStats->initialBudget = depthBudgetFor(n);                                           \
+    matchRange##SUFFIX(keys, locks, n, depthBudgetFor(n), &rng);                                                       \
+}
+
+/*
+@brief this function is the block kernel of the int matcher: the kernel chosen by selectPartitionKernel (the generated scalar one or AVX2). it is called once per partition, the comparisons inside the kernels are inlined.
+@param arr[] -> the array to be partitioned
+@param n -> the number of elements
+@param pivot -> the pivot
+@param inclusive -> 1 if the elements equal to the pivot go to the left side too
+@return the number of elements on the left side
+*/
+static inline size_t partitionBlockSelected(int arr[], size_t n, const int *pivot, int inclusive) {
+    return partitionKernel(arr, n, *pivot, inclusive);
+}
+
+DEFINE_KEY_MATCHER(Int, int, LESS_SCALAR, EQUAL_SCALAR, partitionBlockSelected)
+DEFINE_KEY_MATCHER(I64, int64_t, LESS_SCALAR, EQUAL_SCALAR, partitionBlockI64)
+DEFINE_KEY_MATCHER(U128, Key128, LESS_128, EQUAL_128, partitionBlockU128)
+DEFINE_KEY_MATCHER(Bytes, KeyBytes, LESS_BYTES, EQUAL_BYTES, partitionBlockBytes)
+
+// the distinct benchmark keys of every type, made from the index i
+#define MAKE_KEY_INT(key, i) ((key) = (int)(uint32_t)((uint32_t)(i) * 2654435761u))
+#define MAKE_KEY_I64(key, i) ((key) = (int64_t)((uint64_t)(i) * 0x9E3779B97F4A7C15ULL))
+#define MAKE_KEY_U128(key, i) ((key).high = (uint64_t)(i) * 0x9E3779B97F4A7C15ULL, (key).low = (uint64_t)(i))
+#define MAKE_KEY_BYTES(key, i) makeByteKey(&(key), (uint64_t)(i))
+
+/*
+@brief this function makes a distinct byte string key from a number: a mixed prefix and the number itself at the end (the part that fits in the key).
+@param key -> the key to be filled
+@param i -> the number
+@return
+*/
+static void makeByteKey(KeyBytes *key, uint64_t i) {
+    MatchRng mix;
+    size_t k;
+    initRng(&mix, i);
+    for (k = 0; k < KEY_BYTES_LENGTH; k++)
+        key->bytes[k] = (unsigned char)nextRandom(&mix);
+    for (k = 0; k < 8 && k < KEY_BYTES_LENGTH; k++)
+        key->bytes[KEY_BYTES_LENGTH - 1 - k] = (unsigned char)(i >> (8 * k));
+}
+
+/*
+@brief this macro generates the benchmark of one key type: n distinct keys, both arrays shuffled separately, one timed run of matchKeysAndLocks<SUFFIX> and a check of the pairs.
+@param SUFFIX -> the suffix given to DEFINE_KEY_MATCHER
+@param TYPE -> the key type
+@param MAKE_KEY -> a macro MAKE_KEY(key, i) that stores the i-th distinct key
+@param EQUAL -> the equality macro of the type
+*/
+#define DEFINE_KEY_BENCH(SUFFIX, TYPE, MAKE_KEY, EQUAL)                                                                \
+static double benchmarkKeys##SUFFIX(size_t n, int *correct) {                                                          \
+    TYPE *keys = (TYPE *)malloc(sizeof(TYPE) * n);                                                                     \
+    TYPE *locks = (TYPE *)malloc(sizeof(TYPE) * n);                                                                    \
+    MatchRng rng;                                                                                                      \
+    double start, elapsed;                                                                                             \
+    size_t i;                                                                                                          \
+    initRng(&rng, 99);                                                                                                 \
+    for (i = 0; i < n; i++) {                                                                                          \
+        MAKE_KEY(keys[i], i);                                                                                          \
+        locks[i] = keys[i];                                                                                            \
+    }                                                                                                                  \
+    for (i = n; i > 1; i--) {                                                                                          \
+        swapKeys##SUFFIX(&keys[i - 1], &keys[randomOffset(&rng, i)]);                                                  \
+        swapKeys##SUFFIX(&locks[i - 1], &locks[randomOffset(&rng, i)]);                                                \
+    }                                                                                                                  \
+    start = getTimeInSeconds();                                                                                        \
+    matchKeysAndLocks##SUFFIX(keys, locks, n);                                                                         \
+    elapsed = getTimeInSeconds() - start;                                                                              \
+    *correct = 1;                                                                                                      \
+    for (i = 0; i < n; i++)                                                                                            \
+        *correct &= EQUAL(keys[i], locks[i]);                                                                          \
+    free(keys);                                                                                                        \
+    free(locks);                                                                                                       \
+    return elapsed;                                                                                                    \
+}
+
+DEFINE_KEY_BENCH(Int, int, MAKE_KEY_INT, EQUAL_SCALAR)
+DEFINE_KEY_BENCH(I64, int64_t, MAKE_KEY_I64, EQUAL_SCALAR)
+DEFINE_KEY_BENCH(U128, Key128, MAKE_KEY_U128, EQUAL_128)
+DEFINE_KEY_BENCH(Bytes, KeyBytes, MAKE_KEY_BYTES, EQUAL_BYTES)
 
 /*
 @brief The main function where the program starts execution.
 @return returns an integer that indicates the exit status of the program, to say the program ended succesfully or not
 */
-int main() {
-    int N; //number of elements in keys and locks arrays
-    int i; //index
+int main(int argc, char *argv[]) {
+    size_t N; //number of elements in keys and locks arrays
+    size_t i; //index
     int *keys, *locks; //pointers for the keys and locks arrays
+    int threadCount = 1; // 1 means the serial recursion
+    size_t cutoff = PARALLEL_CUTOFF;
+    size_t benchN = 0; // if it is bigger than 0 the program runs the benchmark instead of the interactive mode
+    int partitionBenchN = 0;
+    int allowSimd = 1;
+    const char *inputPath = NULL, *outputPath = "-";
+    int binaryOutput = 0;
+    int seedGiven = 0;
+    const char *externalPath = NULL, *tempDir = NULL;
+    long memoryLimitMB = 256;
+    size_t harnessN = 0, makeInputN = 0;
+    int rounds = 5, keyWidth = (int)sizeof(int);
+    long long keysBenchN = 0;
+    const char *makeInputPath = NULL;
+    const char *distributions = "random,sorted,reversed,duplicates", *format = "text";
 
-    getInputFromUser(&N, &keys, &locks);
+    for (i = 1; i < (size_t)argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < (size_t)argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < (size_t)argc) {
+            cutoff = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--bench-parallel") == 0 && i + 1 < (size_t)argc) {
+            benchN = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--bench-partition") == 0 && i + 1 < (size_t)argc) {
+            partitionBenchN = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < (size_t)argc) {
+            setMatcherSeed(strtoull(argv[++i], NULL, 10));
+            seedGiven = 1;
+        } else if (strcmp(argv[i], "--no-simd") == 0) {
+            allowSimd = 0;
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < (size_t)argc) {
+            inputPath = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < (size_t)argc) {
+            outputPath = argv[++i];
+        } else if (strcmp(argv[i], "--binary-output") == 0) {
+            binaryOutput = 1;
+        } else if (strcmp(argv[i], "--external") == 0 && i + 1 < (size_t)argc) {
+            externalPath = argv[++i];
+        } else if (strcmp(argv[i], "--memory-limit") == 0 && i + 1 < (size_t)argc) {
+            memoryLimitMB = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--temp-dir") == 0 && i + 1 < (size_t)argc) {
+            tempDir = argv[++i];
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < (size_t)argc) {
+            harnessN = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--bench-keys") == 0 && i + 1 < (size_t)argc) {
+            keysBenchN = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < (size_t)argc) {
+            rounds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dist") == 0 && i + 1 < (size_t)argc) {
+            distributions = argv[++i];
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < (size_t)argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "--make-input") == 0 && i + 2 < (size_t)argc) {
+            makeInputN = (size_t)strtoull(argv[++i], NULL, 10);
+            makeInputPath = argv[++i];
+        } else if (strcmp(argv[i], "--key-width") == 0 && i + 1 < (size_t)argc) {
+            keyWidth = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [-t threads] [-c cutoff] [--no-simd] [--bench-parallel N] [--bench-partition N]\n"
+                            "       [-s seed] [-i input] [-o output] [--binary-output] [--make-input N file [--key-width 4|8|16]]\n"
+                            "       [--external input] [--memory-limit MB] [--temp-dir dir]\n"
+                            "       [--bench N] [--rounds R] [--dist random,sorted,reversed,duplicates] [--format text|csv|json]\n"
+                            "       [--bench-keys N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threadCount < 1) threadCount = 1;
+    if (cutoff < 2) cutoff = 2;
+    if (!seedGiven) setMatcherSeed((uint64_t)time(NULL));
+
+    if (makeInputPath != NULL) {
+        int failed;
+        if (keyWidth != 4 && keyWidth != 8 && keyWidth != 16) {
+            fprintf(stderr, "--key-width must be 4, 8 or 16\n");
+            return 1;
+        }
+        if (keyWidth != (int)sizeof(int)) return writeWideInput(makeInputPath, makeInputN, keyWidth, (uint64_t)time(NULL));
+        generateRandomPairs(makeInputN, &keys, &locks, (unsigned int)time(NULL));
+        failed = writeBinaryInput(makeInputPath, keys, locks, makeInputN);
+        free(keys);
+        free(locks);
+        return failed;
+    }
+
+    selectPartitionKernel(allowSimd);
+
+    if (partitionBenchN > 0) {
+        benchmarkPartition(partitionBenchN, allowSimd);
+        return 0;
+    }
+    if (benchN > 0) {
+        benchmarkParallel(benchN, threadCount, cutoff);
+        return 0;
+    }
+    if (keysBenchN > 0) {
+        benchmarkKeyTypes((size_t)keysBenchN);
+        return 0;
+    }
+    if (harnessN > 0) {
+        return runBenchmark(harnessN, rounds < 1 ? 1 : rounds, distributions, format);
+    }
+
+    if (externalPath != NULL) {
+        if (tempDir == NULL) tempDir = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+        if (memoryLimitMB < 1) memoryLimitMB = 1;
+        return matchExternal(externalPath, outputPath, binaryOutput, (size_t)memoryLimitMB << 20, tempDir);
+    }
+
+    if (inputPath != NULL) {
+        PairInput input;
+        int failed;
 
-    // random number generator
-    srand(time(NULL));
+        if (readPairsFromFile(inputPath, &input) != 0) return 1;
+        if (input.keyWidth == (int)sizeof(int)) {
+            if (threadCount > 1)
+                matchKeysAndLocksParallel((int *)input.keys, (int *)input.locks, input.N, threadCount, cutoff);
+            else
+                matchKeysAndLocksInt((int *)input.keys, (int *)input.locks, input.N);
+        } else {
+            if (threadCount > 1)
+                fprintf(stderr, "the parallel matcher works on 32-bit keys, the %d-bit keys are matched serially\n", input.keyWidth * 8);
+            if (input.keyWidth == 8)
+                matchKeysAndLocksI64((int64_t *)input.keys, (int64_t *)input.locks, input.N);
+            else
+                matchKeysAndLocksU128((Key128 *)input.keys, (Key128 *)input.locks, input.N);
+        }
+        failed = writePairsToFile(outputPath, input.keys, input.locks, input.N, input.keyWidth, binaryOutput);
+        freePairInput(&input);
+        return failed;
+    }
+
+    getInputFromUser(&N, &keys, &locks);
 
-    matchKeysAndLocks(keys, locks, 0, N - 1);
+    if (threadCount > 1)
+        matchKeysAndLocksParallel(keys, locks, N, threadCount, cutoff);
+    else
+        matchKeysAndLocksInt(keys, locks, N);
 
     printf("Matched keys and locks are:\n");
     for ( i = 0; i < N; i++)
@@ -69,49 +694,90 @@ int main() {
 @param locks -> a double pointer to the array of locks for making the allocation
  @return
 */
-void getInputFromUser(int *N, int **keys, int **locks) {
+void getInputFromUser(size_t *N, int **keys, int **locks) {
     printf("Enter the number of keys and locks (N): ");
-    scanf("%d", N);
-    int i;
+    scanf("%zu", N);
+    size_t i;
     *keys = (int *)malloc(sizeof(int) * (*N));
     *locks = (int *)malloc(sizeof(int) * (*N));
 
     printf("Enter the keys and locks (one at a time):\n");
     for (i = 0; i < *N; i++) {
-        printf("Enter the key for lock %d: ", i + 1);
+        printf("Enter the key for lock %zu: ", i + 1);
         scanf("%d", &(*keys)[i]);
     }
 
     for (i = 0; i < *N; i++) {
-        printf("Enter the lock for key %d: ", i + 1);
+        printf("Enter the lock for key %zu: ", i + 1);
         scanf("%d", &(*locks)[i]);
     }
 }
 
 /*
-@brief in this function i make the match for keys and locks by recursively partitioning and matching all the subarrays.
-@param keys[] -> the array of keys to be matched with locks
-@param locks[] -> the array of locks to be matched with keys
-@param low -> the starting index for the matching
-@param high -> the ending index for the matching
- @return
+@brief this function sets the seed that every matching run starts from.
+@param seed -> the new seed
+@return
 */
-void matchKeysAndLocks(int keys[], int locks[], int low, int high) {
-    if (low < high) {
-        // Choose a random pivot index
-        int randomPivotIndex = rand() % (high - low + 1) + low;
-        int pivot = keys[randomPivotIndex]; // Use key as the pivot
+void setMatcherSeed(uint64_t seed) {
+    matcherSeed = seed;
+}
 
-        // Partition the locks based on the pivot key
-        int pivotIndex = makePartition(locks, low, high, pivot);
+/*
+@brief this function starts a generator from a seed.
+@param rng -> the generator
+@param seed -> the seed
+@return
+*/
+void initRng(MatchRng *rng, uint64_t seed) {
+    rng->state = seed;
+}
 
-        // Partition the keys based on the pivot lock
-        makePartition(keys, low, high, locks[pivotIndex]);
+/*
+@brief this function returns the next number of a splitmix64 generator. it is a few additions and multiplications, much cheaper than rand() and it has no shared state between threads.
+@param rng -> the generator
+@return a random 64-bit number
+*/
+uint64_t nextRandom(MatchRng *rng) {
+    uint64_t z = (rng->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*
+@brief this function returns a random index in [low..high], it is randomOffset shifted to low.
+@param rng -> the generator
+@param low -> the smallest index
+@param high -> the biggest index
+@return the random index
+*/
+int randomIndex(MatchRng *rng, int low, int high) {
+    return low + (int)randomOffset(rng, (size_t)((int64_t)high - low + 1));
+}
 
-        // Recur for [low..pivotIndex-1] and [pivotIndex+1..high] for keys and locks array.
-        matchKeysAndLocks(keys, locks, low, pivotIndex - 1);
-        matchKeysAndLocks(keys, locks, pivotIndex + 1, high);
+/*
+@brief this function returns the number of partition levels allowed for a range of n elements, 2*log2(n) like introsort.
+@param n -> the number of elements
+@return the depth budget
+*/
+int depthBudgetFor(size_t n) {
+    int budget = 0;
+    while (n > 1) {
+        budget += 2;
+        n >>= 1;
     }
+    return budget;
+}
+
+/*
+@brief this function returns a random offset in [0..n-1] for any size_t n, ranges up to 2^32 use a multiply and a shift instead of the modulo.
+@param rng -> the generator
+@param n -> the length of the range, it must be bigger than 0
+@return the random offset
+*/
+size_t randomOffset(MatchRng *rng, size_t n) {
+    if ((uint64_t)n <= 0xFFFFFFFFULL) return (size_t)(((nextRandom(rng) >> 32) * (uint64_t)n) >> 32);
+    return (size_t)(nextRandom(rng) % (uint64_t)n);
 }
 
 /*
@@ -159,3 +825,1309 @@ void makeSwap(int *a, int *b) {
     *a = *b;
     *b = temp;
 }
+
+
+/*
+@brief this function adds a task to the bottom of a worker's deque, the deque grows when it is full.
+@param deque -> the deque of the worker that creates the task
+@param task -> the range to be matched later
+@return
+*/
+void pushTask(TaskDeque *deque, MatchTask task) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom == deque->capacity) {
+        if (deque->top > 0) {
+            // stolen tasks left free space at the top, move the remaining tasks to the start
+            memmove(deque->tasks, deque->tasks + deque->top, sizeof(MatchTask) * (deque->bottom - deque->top));
+            deque->bottom -= deque->top;
+            deque->top = 0;
+        } else {
+            deque->capacity *= 2;
+            deque->tasks = (MatchTask *)realloc(deque->tasks, sizeof(MatchTask) * deque->capacity);
+        }
+    }
+    deque->tasks[deque->bottom++] = task;
+    pthread_mutex_unlock(&deque->lock);
+}
+
+/*
+@brief this function takes the newest task from the bottom of the worker's own deque.
+@param deque -> the deque of the worker
+@param task -> the place to write the task
+@return 1 if a task is taken, 0 if the deque is empty
+*/
+int popTask(TaskDeque *deque, MatchTask *task) {
+    int found = 0;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        *task = deque->tasks[--deque->bottom];
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+/*
+@brief this function steals the oldest (so usually the biggest) task from the top of another worker's deque. the first victim is random, then the other workers are tried in order.
+@param pool -> the shared pool of the run
+@param thiefId -> the id of the worker that is looking for work
+@param rng -> the generator of the thief
+@param task -> the place to write the stolen task
+@return 1 if a task is stolen, 0 if all the deques are empty
+*/
+int stealTask(MatchPool *pool, int thiefId, MatchRng *rng, MatchTask *task) {
+    int start = randomIndex(rng, 0, pool->threadCount - 1);
+    int k;
+    for (k = 0; k < pool->threadCount; k++) {
+        int victim = (start + k) % pool->threadCount;
+        TaskDeque *deque = &pool->deques[victim];
+        int found = 0;
+
+        if (victim == thiefId) continue;
+
+        pthread_mutex_lock(&deque->lock);
+        if (deque->bottom > deque->top) {
+            *task = deque->tasks[deque->top++];
+            found = 1;
+        }
+        pthread_mutex_unlock(&deque->lock);
+        if (found) return 1;
+    }
+    return 0;
+}
+
+/*
+@brief this function matches one task. while the range is bigger than the cutoff it partitions it, pushes the right part as a new task and continues with the left part. the small ranges are matched serially by matchRangeInt. the depth budget goes down on every level like in matchRangeInt.
+@param pool -> the shared pool of the run
+@param id -> the id of the worker running the task
+@param rng -> the generator of the worker
+@param task -> the range to be matched
+@return
+*/
+void runMatchTask(MatchPool *pool, int id, MatchRng *rng, MatchTask task) {
+    int *keys = pool->keys + task.low;
+    int *locks = pool->locks + task.low;
+    size_t n = task.n;
+    int depthBudget = task.depthBudget;
+
+    while (n > pool->cutoff && depthBudget > 0) {
+        size_t equalEnd, keysEqualEnd;
+        size_t pivotIndex = makePartitionInt(locks, n, choosePivotInt(keys, n, rng), &equalEnd);
+        makePartitionInt(keys, n, locks[pivotIndex], &keysEqualEnd);
+
+        depthBudget--;
+        if (n - equalEnd > 1) {
+            MatchTask right = {(size_t)(keys - pool->keys) + equalEnd, n - equalEnd, depthBudget};
+            // count the new task before it can be seen by the others, so pendingTasks never reaches 0 too early
+            atomic_fetch_add(&pool->pendingTasks, 1);
+            pushTask(&pool->deques[id], right);
+        }
+        n = pivotIndex;
+    }
+    matchRangeInt(keys, locks, n, depthBudget, rng);
+}
+
+/*
+@brief this function is the loop of a worker thread. it runs its own tasks first and steals from the others when it has nothing to do, until all the tasks are finished.
+@param arg -> a pointer to the WorkerArgs of the worker
+@return NULL
+*/
+void *matchWorker(void *arg) {
+    WorkerArgs *args = (WorkerArgs *)arg;
+    MatchPool *pool = args->pool;
+    MatchTask task;
+
+    while (atomic_load(&pool->pendingTasks) > 0) {
+        if (popTask(&pool->deques[args->id], &task) || stealTask(pool, args->id, &args->rng, &task)) {
+            runMatchTask(pool, args->id, &args->rng, task);
+            atomic_fetch_sub(&pool->pendingTasks, 1);
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/*
+@brief this function matches the keys and locks with the given number of threads. the result is the same as matchKeysAndLocksInt: after it returns keys[i] and locks[i] are a matching pair for all i.
+@param keys[] -> the array of keys to be matched with locks
+@param locks[] -> the array of locks to be matched with keys
+@param N -> the number of keys and locks
+@param threadCount -> the number of threads, the calling thread is one of them
+@param cutoff -> the ranges smaller than this are not split into new tasks
+@return
+*/
+void matchKeysAndLocksParallel(int keys[], int locks[], size_t N, int threadCount, size_t cutoff) {
+    MatchPool pool;
+    WorkerArgs *args;
+    pthread_t *threads;
+    MatchTask first = {0, N, depthBudgetFor(N)};
+    int i;
+
+    if (threadCount <= 1 || N <= cutoff) {
+        matchKeysAndLocksInt(keys, locks, N);
+        return;
+    }
+
+    pool.keys = keys;
+    pool.locks = locks;
+    pool.threadCount = threadCount;
+    pool.cutoff = cutoff;
+    pool.deques = (TaskDeque *)malloc(sizeof(TaskDeque) * threadCount);
+    for (i = 0; i < threadCount; i++) {
+        pool.deques[i].capacity = 64;
+        pool.deques[i].tasks = (MatchTask *)malloc(sizeof(MatchTask) * pool.deques[i].capacity);
+        pool.deques[i].top = 0;
+        pool.deques[i].bottom = 0;
+        pthread_mutex_init(&pool.deques[i].lock, NULL);
+    }
+    atomic_init(&pool.pendingTasks, 1);
+    pushTask(&pool.deques[0], first);
+
+    args = (WorkerArgs *)malloc(sizeof(WorkerArgs) * threadCount);
+    threads = (pthread_t *)malloc(sizeof(pthread_t) * threadCount);
+    for (i = 0; i < threadCount; i++) {
+        args[i].pool = &pool;
+        args[i].id = i;
+        // every worker gets its own stream, worker 0 starts from the same seed as the serial matcher
+        initRng(&args[i].rng, matcherSeed + 0xD1B54A32D192ED03ULL * (uint64_t)i);
+    }
+    // the calling thread works as worker 0
+    for (i = 1; i < threadCount; i++)
+        pthread_create(&threads[i], NULL, matchWorker, &args[i]);
+    matchWorker(&args[0]);
+    for (i = 1; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+
+    for (i = 0; i < threadCount; i++) {
+        pthread_mutex_destroy(&pool.deques[i].lock);
+        free(pool.deques[i].tasks);
+    }
+    free(pool.deques);
+    free(args);
+    free(threads);
+}
+
+/*
+@brief this function returns the time of a monotonic clock, it is used to measure the benchmark.
+@return the current time in seconds
+*/
+double getTimeInSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+@brief this function creates N distinct keys and the same N values as locks, both arrays are shuffled separately with Fisher-Yates.
+@param N -> the number of pairs
+@param keys -> a double pointer to the array of keys for making the allocation
+@param locks -> a double pointer to the array of locks for making the allocation
+@param seed -> the seed of the shuffle
+@return
+*/
+void generateRandomPairs(size_t N, int **keys, int **locks, unsigned int seed) {
+    MatchRng rng;
+    size_t i;
+    *keys = (int *)malloc(sizeof(int) * N);
+    *locks = (int *)malloc(sizeof(int) * N);
+
+    for (i = 0; i < N; i++) {
+        (*keys)[i] = (int)(i + 1);
+        (*locks)[i] = (int)(i + 1);
+    }
+    initRng(&rng, seed);
+    for (i = N; i > 1; i--) {
+        makeSwap(&(*keys)[i - 1], &(*keys)[randomOffset(&rng, i)]);
+        makeSwap(&(*locks)[i - 1], &(*locks)[randomOffset(&rng, i)]);
+    }
+}
+
+/*
+@brief this function checks that every key is next to its own lock.
+@param keys[] -> the matched keys
+@param locks[] -> the matched locks
+@param N -> the number of pairs
+@return 1 if all the pairs match, 0 otherwise
+*/
+int isMatched(int keys[], int locks[], size_t N) {
+    size_t i;
+    for (i = 0; i < N; i++) {
+        if (keys[i] != locks[i]) return 0;
+    }
+    return 1;
+}
+
+/*
+@brief this function measures the serial recursion and the parallel matcher on the same random input and prints the speedup.
+@param N -> the number of pairs
+@param threadCount -> the number of threads for the parallel matcher
+@param cutoff -> the cutoff for the parallel matcher
+@return
+*/
+void benchmarkParallel(size_t N, int threadCount, size_t cutoff) {
+    int *keys, *locks;
+    int *serialKeys, *serialLocks;
+    double start, serialTime, parallelTime;
+
+    generateRandomPairs(N, &keys, &locks, 12345u);
+    serialKeys = (int *)malloc(sizeof(int) * N);
+    serialLocks = (int *)malloc(sizeof(int) * N);
+    memcpy(serialKeys, keys, sizeof(int) * N);
+    memcpy(serialLocks, locks, sizeof(int) * N);
+
+    start = getTimeInSeconds();
+    matchKeysAndLocksInt(serialKeys, serialLocks, N);
+    serialTime = getTimeInSeconds() - start;
+
+    start = getTimeInSeconds();
+    matchKeysAndLocksParallel(keys, locks, N, threadCount, cutoff);
+    parallelTime = getTimeInSeconds() - start;
+
+    printf("N: %zu, threads: %d, cutoff: %zu\n", N, threadCount, cutoff);
+    printf("Serial time: %.3f s, parallel time: %.3f s, speedup: %.2fx\n",
+           serialTime, parallelTime, parallelTime > 0 ? serialTime / parallelTime : 0.0);
+    printf("Serial result: %s, parallel result: %s, same pairing: %s\n",
+           isMatched(serialKeys, serialLocks, N) ? "matched" : "NOT matched",
+           isMatched(keys, locks, N) ? "matched" : "NOT matched",
+           memcmp(keys, serialKeys, sizeof(int) * N) == 0 && memcmp(locks, serialLocks, sizeof(int) * N) == 0 ? "yes" : "no");
+
+    free(keys);
+    free(locks);
+    free(serialKeys);
+    free(serialLocks);
+}
+
+/*
+@brief this function is the portable block kernel of the int matcher, the one that partitionBlockInt generates. it has the signature of partitionKernel so it can be selected at runtime like the AVX2 kernel.
+@param arr[] -> the array to be partitioned
+@param n -> the number of elements
+@param pivot -> the value of the pivot
+@param inclusive -> 1 if the elements equal to the pivot go to the left side too
+@return the number of elements on the left side
+*/
+size_t partitionBlockScalar(int arr[], size_t n, int pivot, int inclusive) {
+    return partitionBlockInt(arr, n, &pivot, inclusive);
+}
+
+#ifdef HAVE_AVX2_KERNEL
+// permutation for every 8-bit compare mask: the lanes that go left first, then the lanes that go right
+static int compressTable[256][8];
+static pthread_once_t compressTableOnce = PTHREAD_ONCE_INIT;
+
+/*
+@brief this function fills compressTable, it is called once before the AVX2 kernel is used.
+@return
+*/
+static void buildCompressTable(void) {
+    int mask, lane;
+    for (mask = 0; mask < 256; mask++) {
+        int count = 0;
+        for (lane = 0; lane < 8; lane++)
+            if (mask & (1 << lane)) compressTable[mask][count++] = lane;
+        for (lane = 0; lane < 8; lane++)
+            if (!(mask & (1 << lane))) compressTable[mask][count++] = lane;
+    }
+}
+
+/*
+@brief this function does the same job as partitionBlockScalar with AVX2, 8 elements at a time and in place. the first and the last vectors are saved so there is always free space at both ends; every loaded vector is compressed with compressTable and written to both the left and the right end, only the correct part of each store is kept. the vector is read from the side with less free space so no unread element is overwritten.
+@param arr[] -> the array to be partitioned
+@param n -> the number of elements
+@param pivot -> the value of the pivot
+@param inclusive -> 1 if the elements equal to the pivot go to the left side too
+@return the number of elements on the left side
+*/
+__attribute__((target("avx2")))
+size_t partitionBlockAVX2(int arr[], size_t n, int pivot, int inclusive) {
+    int rest[24]; // the two saved vectors and the last unread elements
+    int restCount = 0;
+    size_t readLeft = 8, readRight = n - 8, writeLeft = 0, writeRight = n; // readLeft <= readRight all the time
+    size_t i;
+    int k;
+    __m256i pivots, savedLeft, savedRight;
+
+    if (n < 32) return partitionBlockScalar(arr, n, pivot, inclusive);
+
+    pivots = _mm256_set1_epi32(pivot);
+    savedLeft = _mm256_loadu_si256((const __m256i *)arr);
+    savedRight = _mm256_loadu_si256((const __m256i *)(arr + n - 8));
+
+    while (readRight - readLeft >= 8) {
+        __m256i values, goesRight, permuted;
+        int mask, leftCount;
+
+        if (readLeft - writeLeft <= writeRight - readRight) {
+            values = _mm256_loadu_si256((const __m256i *)(arr + readLeft));
+            readLeft += 8;
+        } else {
+            readRight -= 8;
+            values = _mm256_loadu_si256((const __m256i *)(arr + readRight));
+        }
+
+        // a lane goes right if value > pivot (inclusive) or value >= pivot (strict)
+        goesRight = inclusive ? _mm256_cmpgt_epi32(values, pivots)
+                              : _mm256_or_si256(_mm256_cmpgt_epi32(values, pivots), _mm256_cmpeq_epi32(values, pivots));
+        mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(goesRight)) & 0xFF;
+        leftCount = __builtin_popcount(mask);
+        permuted = _mm256_permutevar8x32_epi32(values, _mm256_loadu_si256((const __m256i *)compressTable[mask]));
+
+        _mm256_storeu_si256((__m256i *)(arr + writeLeft), permuted);
+        _mm256_storeu_si256((__m256i *)(arr + writeRight - 8), permuted);
+        writeLeft += (size_t)leftCount;
+        writeRight -= (size_t)(8 - leftCount);
+    }
+
+    // the free space is exactly as big as the elements in rest, so they can be written one by one
+    _mm256_storeu_si256((__m256i *)rest, savedLeft);
+    _mm256_storeu_si256((__m256i *)(rest + 8), savedRight);
+    restCount = 16;
+    for (i = readLeft; i < readRight; i++)
+        rest[restCount++] = arr[i];
+    for (k = 0; k < restCount; k++) {
+        int x = rest[k];
+        if ((x < pivot) | ((x == pivot) & inclusive))
+            arr[writeLeft++] = x;
+        else
+            arr[--writeRight] = x;
+    }
+    return writeLeft;
+}
+#endif
+
+/*
+@brief this function chooses the block kernel of the int matcher (makePartitionInt) by looking at the CPU at runtime.
+@param allowSimd -> 0 forces the portable kernel
+@return
+*/
+void selectPartitionKernel(int allowSimd) {
+    partitionKernel = partitionBlockScalar;
+#ifdef HAVE_AVX2_KERNEL
+    if (allowSimd && __builtin_cpu_supports("avx2")) {
+        pthread_once(&compressTableOnce, buildCompressTable);
+        partitionKernel = partitionBlockAVX2;
+    }
+#else
+    (void)allowSimd;
+#endif
+}
+
+/*
+@brief this function checks a three-way partition result.
+@param arr[] -> the partitioned array
+@param n -> the number of elements
+@param pivot -> the pivot value
+@param pivotIndex -> the first index of the pivot
+@param equalHigh -> the last index of the pivot
+@return 1 if it is correct, 0 otherwise
+*/
+static int isPartitioned(int arr[], int n, int pivot, int pivotIndex, int equalHigh) {
+    int i;
+    for (i = 0; i < n; i++) {
+        if (i < pivotIndex && arr[i] >= pivot) return 0;
+        if (i >= pivotIndex && i <= equalHigh && arr[i] != pivot) return 0;
+        if (i > equalHigh && arr[i] <= pivot) return 0;
+    }
+    return 1;
+}
+
+/*
+@brief this function measures how many elements per second makePartition and the kernels of makePartitionInt can partition on random keys.
+@param N -> the number of elements in each run
+@param allowSimd -> 0 skips the AVX2 kernel
+@return
+*/
+void benchmarkPartition(int N, int allowSimd) {
+    int *keys, *locks, *work;
+    int rounds = N >= 1000000 ? 5 : 50;
+    int round, kernel, pivotIndex, equalHigh, correct;
+    double start, elapsed;
+    const char *names[] = {"makePartition", "makePartitionInt (scalar)", "makePartitionInt (AVX2)"};
+
+    generateRandomPairs(N, &keys, &locks, 777u);
+    work = (int *)malloc(sizeof(int) * N);
+    printf("N: %d, rounds: %d\n", N, rounds);
+
+    for (kernel = 0; kernel < 3; kernel++) {
+        if (kernel == 1) selectPartitionKernel(0);
+        if (kernel == 2) {
+            selectPartitionKernel(allowSimd);
+            if (partitionKernel == partitionBlockScalar) {
+                printf("%-28s not available on this CPU\n", names[kernel]);
+                break;
+            }
+        }
+
+        elapsed = 0;
+        correct = 1;
+        for (round = 0; round < rounds; round++) {
+            int pivot = keys[(round * 7919) % N];
+            memcpy(work, keys, sizeof(int) * N);
+            start = getTimeInSeconds();
+            if (kernel == 0) {
+                pivotIndex = makePartition(work, 0, N - 1, pivot);
+                equalHigh = pivotIndex;
+            } else {
+                size_t equalEnd;
+                pivotIndex = (int)makePartitionInt(work, (size_t)N, pivot, &equalEnd);
+                equalHigh = (int)equalEnd - 1;
+            }
+            elapsed += getTimeInSeconds() - start;
+            correct &= isPartitioned(work, N, pivot, pivotIndex, equalHigh);
+        }
+        printf("%-28s %10.1f M elements/s  %s\n", names[kernel],
+               elapsed > 0 ? (double)N * rounds / elapsed / 1e6 : 0.0, correct ? "ok" : "WRONG");
+    }
+    selectPartitionKernel(allowSimd);
+
+    free(keys);
+    free(locks);
+    free(work);
+}
+
+/*
+@brief this function reads the next integer from a text buffer, it skips the whitespace before the number. it is much faster than scanf because it does not parse a format string and does no locking.
+@param cursor -> a pointer to the current position, it is moved after the number
+@param end -> the end of the buffer
+@param value -> the place to write the number
+@return 1 if a number is read, 0 at the end of the buffer or when the next character is not a digit
+*/
+int parseNextInt(const char **cursor, const char *end, long long *value) {
+    const char *p = *cursor;
+    long long result = 0;
+    int negative = 0;
+
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r')) p++;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') return 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p - '0');
+        if (result > 100000000000000000LL) return 0; // far out of any range used here, stop before it overflows
+        p++;
+    }
+
+    *value = negative ? -result : result;
+    *cursor = p;
+    return 1;
+}
+
+/*
+@brief this function opens an input file and memory-maps it. a binary file is mapped privately with write permission, so the matcher can reorder the arrays in place and the file on disk does not change; its keys are 4, 8 or 16 bytes wide (byte 4 of the header, 0 means 4). a text file holds int keys, it is parsed into new arrays.
+@param path -> the path of the input file
+@param input -> the structure to be filled
+@return 0 on success, 1 on error (the error is printed)
+*/
+int readPairsFromFile(const char *path, PairInput *input) {
+    struct stat info;
+    char *data;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        perror(path);
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+    input->mapping = NULL;
+    input->mappingLength = (size_t)info.st_size;
+    input->keys = input->locks = NULL;
+    input->N = 0;
+    input->keyWidth = (int)sizeof(int);
+    if (info.st_size == 0) {
+        fprintf(stderr, "%s: the file is empty\n", path);
+        close(fd);
+        return 1;
+    }
+
+    data = (char *)mmap(NULL, input->mappingLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror(path);
+        return 1;
+    }
+
+    if (input->mappingLength >= BINARY_HEADER_SIZE && memcmp(data, BINARY_MAGIC, 4) == 0) {
+        int64_t count;
+        int keyWidth = data[4] == 0 ? (int)sizeof(int) : (unsigned char)data[4];
+        memcpy(&count, data + 8, sizeof(count));
+        if (keyWidth != 4 && keyWidth != 8 && keyWidth != 16) {
+            fprintf(stderr, "%s: the key width in the header must be 4, 8 or 16 bytes\n", path);
+            munmap(data, input->mappingLength);
+            return 1;
+        }
+        if (count < 0 || (uint64_t)count > (input->mappingLength - BINARY_HEADER_SIZE) / (2 * (size_t)keyWidth) ||
+            (size_t)count * 2 * (size_t)keyWidth != input->mappingLength - BINARY_HEADER_SIZE) {
+            fprintf(stderr, "%s: the size in the header does not match the file\n", path);
+            munmap(data, input->mappingLength);
+            return 1;
+        }
+        posix_madvise(data, input->mappingLength, POSIX_MADV_WILLNEED);
+        input->mapping = data;
+        input->N = (size_t)count;
+        input->keyWidth = keyWidth;
+        input->keys = data + BINARY_HEADER_SIZE; // the mapping is page aligned, so the keys of every width are aligned
+        input->locks = data + BINARY_HEADER_SIZE + (size_t)count * (size_t)keyWidth;
+        return 0;
+    } else {
+        const char *cursor = data, *end = data + input->mappingLength;
+        long long value;
+        size_t i;
+        int ok = parseNextInt(&cursor, end, &value) && value >= 0 && (uint64_t)value <= SIZE_MAX / (2 * sizeof(int));
+
+        if (ok) {
+            int *keys = (int *)malloc(sizeof(int) * (value > 0 ? (size_t)value : 1));
+            int *locks = (int *)malloc(sizeof(int) * (value > 0 ? (size_t)value : 1));
+            input->N = (size_t)value;
+            input->keys = keys;
+            input->locks = locks;
+            ok = keys != NULL && locks != NULL;
+            for (i = 0; ok && i < 2 * input->N; i++) {
+                ok = parseNextInt(&cursor, end, &value) && value >= -2147483648LL && value <= 2147483647LL;
+                if (i < input->N) keys[i] = (int)value;
+                else locks[i - input->N] = (int)value;
+            }
+        }
+        munmap(data, input->mappingLength);
+        if (!ok) {
+            fprintf(stderr, "%s: expected N followed by N keys and N locks\n", path);
+            freePairInput(input);
+            return 1;
+        }
+        return 0;
+    }
+}
+
+/*
+@brief this function releases the arrays of a PairInput, it unmaps the file if the arrays were mapped.
+@param input -> the input to be freed
+@return
+*/
+void freePairInput(PairInput *input) {
+    if (input->mapping != NULL) {
+        munmap(input->mapping, input->mappingLength);
+    } else {
+        free(input->keys);
+        free(input->locks);
+    }
+    input->mapping = NULL;
+    input->keys = input->locks = NULL;
+    input->N = 0;
+}
+
+/*
+@brief this function appends bytes to the output buffer and writes the buffer to the file when it is full.
+@param out -> the output buffer
+@param data -> the bytes to be written
+@param length -> the number of bytes
+@return
+*/
+void writeBytes(OutputBuffer *out, const void *data, size_t length) {
+    const char *bytes = (const char *)data;
+    while (length > 0) {
+        size_t space = OUTPUT_BUFFER_SIZE - out->used;
+        size_t chunk = length < space ? length : space;
+        memcpy(out->buffer + out->used, bytes, chunk);
+        out->used += chunk;
+        out->written += chunk;
+        bytes += chunk;
+        length -= chunk;
+        if (out->used == OUTPUT_BUFFER_SIZE) {
+            fwrite(out->buffer, 1, out->used, out->file);
+            out->used = 0;
+        }
+    }
+}
+
+/*
+@brief this function writes an integer as decimal text to the output buffer without printf.
+@param out -> the output buffer
+@param value -> the integer to be written
+@return
+*/
+void writeInt(OutputBuffer *out, long long value) {
+    char digits[20];
+    int length = 0;
+    unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long)value : (unsigned long long)value;
+
+    do {
+        digits[19 - length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) digits[19 - length++] = '-';
+    writeBytes(out, digits + 20 - length, (size_t)length);
+}
+
+/*
+@brief this function writes one key as text: int and 64-bit keys in decimal, 128-bit ids as 0x and 32 hex digits.
+@param out -> the output buffer
+@param key -> the key
+@param keyWidth -> the size of the key in bytes: 4, 8 or 16
+@return
+*/
+void writeKey(OutputBuffer *out, const void *key, int keyWidth) {
+    if (keyWidth == 4) {
+        writeInt(out, *(const int *)key);
+    } else if (keyWidth == 8) {
+        writeInt(out, *(const int64_t *)key);
+    } else {
+        const Key128 *id = (const Key128 *)key;
+        char hex[34];
+        int k;
+        hex[0] = '0';
+        hex[1] = 'x';
+        for (k = 0; k < 32; k++) {
+            uint64_t half = k < 16 ? id->high : id->low;
+            hex[2 + k] = "0123456789abcdef"[(half >> (4 * (15 - k % 16))) & 15];
+        }
+        writeBytes(out, hex, sizeof(hex));
+    }
+}
+
+/*
+@brief this function opens a file for an OutputBuffer and allocates the buffer.
+@param out -> the output buffer
+@param path -> the path of the output file, "-" means stdout
+@return 0 on success, 1 on error
+*/
+int openOutputBuffer(OutputBuffer *out, const char *path) {
+    out->file = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+    if (out->file == NULL) {
+        perror(path);
+        return 1;
+    }
+    out->buffer = (char *)malloc(OUTPUT_BUFFER_SIZE);
+    out->used = 0;
+    out->written = 0;
+    return 0;
+}
+
+/*
+@brief this function writes matched pairs as text lines, the same lines as the interactive mode prints.
+@param out -> the output buffer
+@param keys -> the matched keys
+@param locks -> the matched locks
+@param n -> the number of pairs
+@param keyWidth -> the size of one key in bytes
+@return
+*/
+void writePairLines(OutputBuffer *out, const void *keys, const void *locks, size_t n, int keyWidth) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        writeBytes(out, "Key: ", 5);
+        writeKey(out, (const char *)keys + i * (size_t)keyWidth, keyWidth);
+        writeBytes(out, ", Lock: ", 8);
+        writeKey(out, (const char *)locks + i * (size_t)keyWidth, keyWidth);
+        writeBytes(out, "\n", 1);
+    }
+}
+
+/*
+@brief this function writes the rest of the buffer, frees it and closes the file.
+@param out -> the output buffer
+@param path -> the path of the output file, for the error message
+@return 0 on success, 1 on error
+*/
+int closeOutputBuffer(OutputBuffer *out, const char *path) {
+    int failed;
+
+    fwrite(out->buffer, 1, out->used, out->file);
+    free(out->buffer);
+    out->buffer = NULL;
+
+    failed = ferror(out->file) != 0;
+    if (out->file == stdout) failed |= fflush(stdout) != 0;
+    else failed |= fclose(out->file) != 0;
+    if (failed) perror(path);
+    return failed;
+}
+
+/*
+@brief this function writes the header of a binary file: the magic, the key width in byte 4, three zero bytes and N.
+@param out -> the output buffer
+@param N -> the number of pairs
+@param keyWidth -> the size of one key in bytes
+@return
+*/
+void writeBinaryHeader(OutputBuffer *out, size_t N, int keyWidth) {
+    char flags[4] = {(char)keyWidth, 0, 0, 0};
+    int64_t count = (int64_t)N;
+    writeBytes(out, BINARY_MAGIC, 4);
+    writeBytes(out, flags, sizeof(flags));
+    writeBytes(out, &count, sizeof(count));
+}
+
+/*
+@brief this function writes the matched pairs to a file through one big buffer. the text output has the same lines as the interactive mode, the binary output has the same format as a binary input file.
+@param path -> the path of the output file, "-" means stdout
+@param keys -> the matched keys
+@param locks -> the matched locks
+@param N -> the number of pairs
+@param keyWidth -> the size of one key in bytes: 4 (int), 8 (int64_t) or 16 (Key128)
+@param binary -> 1 for the binary format
+@return 0 on success, 1 on error
+*/
+int writePairsToFile(const char *path, const void *keys, const void *locks, size_t N, int keyWidth, int binary) {
+    OutputBuffer out;
+
+    if (openOutputBuffer(&out, path) != 0) return 1;
+
+    if (binary) {
+        writeBinaryHeader(&out, N, keyWidth);
+        writeBytes(&out, keys, (size_t)keyWidth * N);
+        writeBytes(&out, locks, (size_t)keyWidth * N);
+    } else {
+        writeBytes(&out, "Matched keys and locks are:\n", 28);
+        writePairLines(&out, keys, locks, N, keyWidth);
+    }
+    return closeOutputBuffer(&out, path);
+}
+
+/*
+@brief this function writes keys and locks as a binary input file, it is used to prepare big inputs for the -i mode.
+@param path -> the path of the file
+@param keys[] -> the keys
+@param locks[] -> the locks
+@param N -> the number of pairs
+@return 0 on success, 1 on error
+*/
+int writeBinaryInput(const char *path, int keys[], int locks[], size_t N) {
+    return writePairsToFile(path, keys, locks, N, (int)sizeof(int), 1);
+}
+
+/*
+@brief this function writes N random distinct 64-bit or 128-bit keys and the same values as locks to a binary input file, both arrays shuffled separately.
+@param path -> the path of the file
+@param N -> the number of pairs
+@param keyWidth -> 8 or 16
+@param seed -> the seed of the shuffle
+@return 0 on success, 1 on error
+*/
+int writeWideInput(const char *path, size_t N, int keyWidth, uint64_t seed) {
+    unsigned char *keys = (unsigned char *)malloc((size_t)keyWidth * (N > 0 ? N : 1));
+    unsigned char *locks = (unsigned char *)malloc((size_t)keyWidth * (N > 0 ? N : 1));
+    unsigned char *arrays[2];
+    MatchRng rng;
+    size_t i;
+    int a, failed;
+
+    if (keys == NULL || locks == NULL) {
+        fprintf(stderr, "%s: not enough memory for %zu pairs\n", path, N);
+        free(keys);
+        free(locks);
+        return 1;
+    }
+    for (i = 0; i < N; i++) {
+        if (keyWidth == 8) MAKE_KEY_I64(((int64_t *)keys)[i], i + 1);
+        else MAKE_KEY_U128(((Key128 *)keys)[i], i + 1);
+    }
+    memcpy(locks, keys, (size_t)keyWidth * N);
+    initRng(&rng, seed);
+    arrays[0] = keys;
+    arrays[1] = locks;
+    for (a = 0; a < 2; a++) {
+        for (i = N; i > 1; i--) {
+            unsigned char temp[16];
+            unsigned char *x = arrays[a] + (i - 1) * (size_t)keyWidth;
+            unsigned char *y = arrays[a] + randomOffset(&rng, i) * (size_t)keyWidth;
+            memcpy(temp, x, (size_t)keyWidth);
+            memcpy(x, y, (size_t)keyWidth);
+            memcpy(y, temp, (size_t)keyWidth);
+        }
+    }
+    failed = writePairsToFile(path, keys, locks, N, keyWidth, 1);
+    free(keys);
+    free(locks);
+    return failed;
+}
+
+/*
+@brief this function creates a temporary file in the temp directory and removes its name at once, so it is deleted when it is closed even if the program stops.
+@param ctx -> the out-of-core run
+@return the opened file or NULL
+*/
+FILE *openTempFile(ExternalContext *ctx) {
+    char path[4096];
+    FILE *file;
+    int fd;
+
+    snprintf(path, sizeof(path), "%s/locksandkeys-XXXXXX", ctx->tempDir);
+    fd = mkstemp(path);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+    unlink(path);
+    file = fdopen(fd, "w+b");
+    if (file != NULL) setvbuf(file, NULL, _IOFBF, EXTERNAL_FILE_BUFFER);
+    return file;
+}
+
+/*
+@brief this function reads the next integers of a stream and counts the read bytes.
+@param ctx -> the out-of-core run
+@param file -> the stream, it must be at the right position
+@param buffer -> the place to read into
+@param count -> the number of integers wanted
+@return the number of integers read
+*/
+size_t readRangeInts(ExternalContext *ctx, FILE *file, int *buffer, size_t count) {
+    size_t got = fread(buffer, sizeof(int), count, file);
+    ctx->bytesRead += got * sizeof(int);
+    return got;
+}
+
+/*
+@brief this function sends matched pairs to the output of the out-of-core run, in the order they are matched.
+@param ctx -> the out-of-core run
+@param keys[] -> the matched keys
+@param locks[] -> the matched locks
+@param n -> the number of pairs
+@return
+*/
+void emitMatchedPairs(ExternalContext *ctx, int keys[], int locks[], size_t n) {
+    if (ctx->binary) {
+        writeBytes(&ctx->out, keys, sizeof(int) * n);
+        ctx->bytesWritten += fwrite(locks, sizeof(int), n, ctx->locksCopy) * sizeof(int);
+    } else {
+        writePairLines(&ctx->out, keys, locks, n, (int)sizeof(int));
+    }
+}
+
+/*
+@brief this function finds the bucket of a value: the index of the first pivot that is not less than it, or pivotCount if it is bigger than all of them.
+@param pivots[] -> the sorted pivots
+@param pivotCount -> the number of pivots
+@param value -> the value
+@return the bucket index
+*/
+static int findBucket(const int pivots[], int pivotCount, int value) {
+    int low = 0, high = pivotCount;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (pivots[middle] < value) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+/*
+@brief this function matches one range of the out-of-core run. a range that fits in the memory limit is loaded and matched with matchKeysAndLocksInt. a bigger one is split: sampled keys are the pivots, one pass puts every lock into the bucket of its pivot (the locks equal to a pivot key end the bucket), a second pass does the same for the keys with those locks, then every bucket is matched in order. a bucket that holds only one value is written out without matching.
+@param ctx -> the out-of-core run
+@param range -> the keys and the locks of the range
+@param level -> the number of splits above this range
+@return 0 on success, 1 on error
+*/
+int matchExternalRange(ExternalContext *ctx, ExternalRange range, int level) {
+    FILE *keyBuckets[EXTERNAL_MAX_BUCKETS], *lockBuckets[EXTERNAL_MAX_BUCKETS];
+    long long keyCounts[EXTERNAL_MAX_BUCKETS], lockCounts[EXTERNAL_MAX_BUCKETS];
+    int bucketMin[EXTERNAL_MAX_BUCKETS], bucketMax[EXTERNAL_MAX_BUCKETS];
+    int pivots[EXTERNAL_MAX_BUCKETS], samples[EXTERNAL_MAX_BUCKETS * EXTERNAL_SAMPLES_PER_PIVOT];
+    int *chunk;
+    int bucketCount, pivotCount, sampleCount, pass, b, i, failed = 0;
+    size_t k;
+    long long done;
+    size_t rangeBytes = (size_t)range.n * 2 * sizeof(int);
+
+    if (level > ctx->deepestLevel) ctx->deepestLevel = level;
+
+    if (rangeBytes <= ctx->memoryLimit) {
+        int *keys = (int *)malloc(sizeof(int) * (range.n > 0 ? range.n : 1));
+        int *locks = (int *)malloc(sizeof(int) * (range.n > 0 ? range.n : 1));
+
+        // at the first level the keys and the locks are the same input stream, so each seek is followed by its read
+        fseeko(range.keysFile, range.keysOffset, SEEK_SET);
+        failed = readRangeInts(ctx, range.keysFile, keys, (size_t)range.n) != (size_t)range.n;
+        fseeko(range.locksFile, range.locksOffset, SEEK_SET);
+        failed = failed || readRangeInts(ctx, range.locksFile, locks, (size_t)range.n) != (size_t)range.n;
+        if (failed) {
+            fprintf(stderr, "external: %s is shorter than expected\n", level == 0 ? "the input file" : "a temporary file");
+        } else {
+            matchKeysAndLocksInt(keys, locks, (size_t)range.n);
+            emitMatchedPairs(ctx, keys, locks, (size_t)range.n);
+            ctx->bucketsMatched++;
+        }
+        free(keys);
+        free(locks);
+        return failed;
+    }
+
+    // enough buckets that most of them fit in memory after one split, but not more than the file buffers allow
+    bucketCount = (int)(rangeBytes / ctx->memoryLimit) * 2 + 2;
+    if (bucketCount > EXTERNAL_MAX_BUCKETS) bucketCount = EXTERNAL_MAX_BUCKETS;
+
+    pivotCount = 0;
+    if (range.splitByMiddle) {
+        // minValue <= middle < maxValue, so both buckets get at least one value
+        pivots[pivotCount++] = range.minValue + (int)(((long long)range.maxValue - range.minValue) / 2);
+    } else {
+        // sample keys from random positions, sort them and take every EXTERNAL_SAMPLES_PER_PIVOT-th one as a pivot
+        sampleCount = (bucketCount - 1) * EXTERNAL_SAMPLES_PER_PIVOT;
+        for (i = 0; i < sampleCount; i++) {
+            long long position = (long long)(nextRandom(&ctx->rng) % (uint64_t)range.n);
+            fseeko(range.keysFile, range.keysOffset + (off_t)position * (off_t)sizeof(int), SEEK_SET);
+            if (readRangeInts(ctx, range.keysFile, &samples[i], 1) != 1) return 1;
+        }
+        heapSortInt(samples, (size_t)sampleCount);
+        for (i = EXTERNAL_SAMPLES_PER_PIVOT / 2; i < sampleCount; i += EXTERNAL_SAMPLES_PER_PIVOT) {
+            if (pivotCount == 0 || pivots[pivotCount - 1] != samples[i]) pivots[pivotCount++] = samples[i];
+        }
+    }
+    bucketCount = pivotCount + 1;
+
+    for (b = 0; b < bucketCount; b++) {
+        keyBuckets[b] = openTempFile(ctx);
+        lockBuckets[b] = openTempFile(ctx);
+        if (keyBuckets[b] == NULL || lockBuckets[b] == NULL) {
+            for (; b >= 0; b--) {
+                if (keyBuckets[b] != NULL) fclose(keyBuckets[b]);
+                if (lockBuckets[b] != NULL) fclose(lockBuckets[b]);
+            }
+            return 1;
+        }
+        keyCounts[b] = lockCounts[b] = 0;
+        bucketMin[b] = 0x7FFFFFFF;
+        bucketMax[b] = -0x7FFFFFFF - 1;
+    }
+
+    // pass 0: the pivot keys split the locks, pass 1: the locks that matched the pivots split the keys
+    chunk = (int *)malloc(sizeof(int) * EXTERNAL_CHUNK);
+    for (pass = 0; pass < 2; pass++) {
+        FILE *source = pass == 0 ? range.locksFile : range.keysFile;
+        FILE **buckets = pass == 0 ? lockBuckets : keyBuckets;
+        long long *counts = pass == 0 ? lockCounts : keyCounts;
+
+        fseeko(source, pass == 0 ? range.locksOffset : range.keysOffset, SEEK_SET);
+        for (done = 0; done < range.n;) {
+            size_t want = range.n - done < EXTERNAL_CHUNK ? (size_t)(range.n - done) : EXTERNAL_CHUNK;
+            size_t got = readRangeInts(ctx, source, chunk, want);
+            if (got != want) {
+                fprintf(stderr, "external: the input ended early\n");
+                failed = 1;
+                break;
+            }
+            for (k = 0; k < got; k++) {
+                int value = chunk[k];
+                b = findBucket(pivots, pivotCount, value);
+                fwrite(&value, sizeof(int), 1, buckets[b]);
+                counts[b]++;
+                if (value < bucketMin[b]) bucketMin[b] = value;
+                if (value > bucketMax[b]) bucketMax[b] = value;
+            }
+            done += (long long)got;
+        }
+    }
+    free(chunk);
+
+    for (b = 0; !failed && b < bucketCount; b++) {
+        ctx->bytesWritten += (unsigned long long)(keyCounts[b] + lockCounts[b]) * sizeof(int);
+        if (keyCounts[b] != lockCounts[b] || fflush(keyBuckets[b]) != 0 || fflush(lockBuckets[b]) != 0) {
+            fprintf(stderr, "external: %s\n", keyCounts[b] != lockCounts[b] ? "the keys and the locks do not match" : "cannot write a temporary file");
+            failed = 1;
+        }
+    }
+
+    for (b = 0; !failed && b < bucketCount; b++) {
+        if (keyCounts[b] == 0) continue;
+
+        if (bucketMin[b] == bucketMax[b]) {
+            // every key and every lock of this bucket is the same value, they match each other as they are
+            int *same = (int *)malloc(sizeof(int) * EXTERNAL_CHUNK);
+            for (i = 0; i < EXTERNAL_CHUNK; i++) same[i] = bucketMin[b];
+            for (done = 0; done < keyCounts[b]; done += EXTERNAL_CHUNK) {
+                long long n = keyCounts[b] - done < EXTERNAL_CHUNK ? keyCounts[b] - done : EXTERNAL_CHUNK;
+                emitMatchedPairs(ctx, same, same, (size_t)n);
+            }
+            free(same);
+            ctx->bucketsMatched++;
+        } else {
+            ExternalRange bucket;
+            bucket.keysFile = keyBuckets[b];
+            bucket.keysOffset = 0;
+            bucket.locksFile = lockBuckets[b];
+            bucket.locksOffset = 0;
+            bucket.n = keyCounts[b];
+            // if the samples did not split anything (very skewed values) the bucket is split by the middle value
+            bucket.splitByMiddle = bucket.n == range.n;
+            bucket.minValue = bucketMin[b];
+            bucket.maxValue = bucketMax[b];
+            failed = matchExternalRange(ctx, bucket, level + 1);
+        }
+    }
+
+    for (b = 0; b < bucketCount; b++) {
+        fclose(keyBuckets[b]);
+        fclose(lockBuckets[b]);
+    }
+    return failed;
+}
+
+/*
+@brief this function runs the out-of-core matcher on a binary input file and prints the I/O volume and the peak memory to stderr.
+@param inputPath -> the binary input file
+@param outputPath -> the output file, "-" means stdout
+@param binary -> 1 for the binary output format
+@param memoryLimit -> the biggest range (keys and locks together, in bytes) that is matched in memory
+@param tempDir -> the directory of the temporary bucket files
+@return 0 on success, 1 on error
+*/
+int matchExternal(const char *inputPath, const char *outputPath, int binary, size_t memoryLimit, const char *tempDir) {
+    ExternalContext ctx;
+    ExternalRange range;
+    struct rusage usage;
+    struct stat info;
+    char header[BINARY_HEADER_SIZE];
+    int64_t count;
+    double start = getTimeInSeconds();
+    int failed;
+    FILE *input = fopen(inputPath, "rb");
+
+    if (input == NULL || fstat(fileno(input), &info) != 0) {
+        perror(inputPath);
+        if (input != NULL) fclose(input);
+        return 1;
+    }
+    if (fread(header, 1, BINARY_HEADER_SIZE, input) != BINARY_HEADER_SIZE || memcmp(header, BINARY_MAGIC, 4) != 0) {
+        fprintf(stderr, "%s: the out-of-core mode needs a binary input file\n", inputPath);
+        fclose(input);
+        return 1;
+    }
+    if (header[4] != 0 && header[4] != (char)sizeof(int)) {
+        fprintf(stderr, "%s: the out-of-core mode works on 32-bit keys, match wider keys with -i\n", inputPath);
+        fclose(input);
+        return 1;
+    }
+    memcpy(&count, header + 8, sizeof(count));
+    if (count < 0 || (off_t)count * 2 * (off_t)sizeof(int) != info.st_size - BINARY_HEADER_SIZE) {
+        fprintf(stderr, "%s: the size in the header does not match the file\n", inputPath);
+        fclose(input);
+        return 1;
+    }
+    setvbuf(input, NULL, _IOFBF, EXTERNAL_FILE_BUFFER);
+
+    ctx.memoryLimit = memoryLimit;
+    ctx.tempDir = tempDir;
+    ctx.binary = binary;
+    ctx.bytesRead = BINARY_HEADER_SIZE;
+    ctx.bytesWritten = 0;
+    ctx.bucketsMatched = 0;
+    ctx.deepestLevel = 0;
+    ctx.locksCopy = NULL;
+    initRng(&ctx.rng, matcherSeed);
+    if (binary && (ctx.locksCopy = openTempFile(&ctx)) == NULL) {
+        fclose(input);
+        return 1;
+    }
+    if (openOutputBuffer(&ctx.out, outputPath) != 0) {
+        if (ctx.locksCopy != NULL) fclose(ctx.locksCopy);
+        fclose(input);
+        return 1;
+    }
+
+    if (binary) {
+        writeBinaryHeader(&ctx.out, (size_t)count, (int)sizeof(int));
+    } else {
+        writeBytes(&ctx.out, "Matched keys and locks are:\n", 28);
+    }
+
+    range.keysFile = input;
+    range.keysOffset = BINARY_HEADER_SIZE;
+    range.locksFile = input;
+    range.locksOffset = BINARY_HEADER_SIZE + (off_t)count * (off_t)sizeof(int);
+    range.n = count;
+    range.splitByMiddle = 0;
+    range.minValue = range.maxValue = 0;
+    failed = matchExternalRange(&ctx, range, 0);
+
+    if (!failed && binary) {
+        // the locks come after all the keys in the binary format, copy them from the temporary file
+        int *chunk = (int *)malloc(sizeof(int) * EXTERNAL_CHUNK);
+        size_t got;
+        fflush(ctx.locksCopy);
+        fseeko(ctx.locksCopy, 0, SEEK_SET);
+        while ((got = readRangeInts(&ctx, ctx.locksCopy, chunk, EXTERNAL_CHUNK)) > 0)
+            writeBytes(&ctx.out, chunk, got * sizeof(int));
+        free(chunk);
+    }
+    if (ctx.locksCopy != NULL) fclose(ctx.locksCopy);
+    failed |= closeOutputBuffer(&ctx.out, outputPath);
+    fclose(input);
+
+    getrusage(RUSAGE_SELF, &usage);
+    fprintf(stderr, "External matching of %lld pairs %s in %.3f s\n", (long long)count, failed ? "FAILED" : "finished",
+            getTimeInSeconds() - start);
+    fprintf(stderr, "Memory limit: %zu MB, buckets matched: %lld, deepest split level: %d\n",
+            memoryLimit >> 20, ctx.bucketsMatched, ctx.deepestLevel);
+    fprintf(stderr, "I/O: %.1f MB read, %.1f MB written to temporary files, %.1f MB of output\n",
+            ctx.bytesRead / 1048576.0, ctx.bytesWritten / 1048576.0, ctx.out.written / 1048576.0);
+    fprintf(stderr, "Peak RSS: %.1f MB\n", usage.ru_maxrss / 1024.0);
+    return failed;
+}
+
+/*
+@brief this function creates N keys and the same values as locks with the given distribution. random shuffles both arrays separately, sorted and reversed keep both arrays in ascending or descending order, duplicates uses only about sqrt(N) different values in random order.
+@param N -> the number of pairs
+@param distribution -> the distribution of the values
+@param keys -> a double pointer to the array of keys for making the allocation
+@param locks -> a double pointer to the array of locks for making the allocation
+@param seed -> the seed of the shuffle
+@return
+*/
+void generatePairs(size_t N, PairDistribution distribution, int **keys, int **locks, unsigned int seed) {
+    MatchRng rng;
+    int distinct = 1;
+    size_t i;
+
+    if (distribution == DIST_RANDOM) {
+        generateRandomPairs(N, keys, locks, seed);
+        return;
+    }
+
+    *keys = (int *)malloc(sizeof(int) * N);
+    *locks = (int *)malloc(sizeof(int) * N);
+    while ((size_t)distinct * (size_t)distinct < N) distinct++;
+    initRng(&rng, seed);
+
+    for (i = 0; i < N; i++) {
+        int value;
+        if (distribution == DIST_SORTED) value = (int)(i + 1);
+        else if (distribution == DIST_REVERSED) value = (int)(N - i);
+        else value = randomIndex(&rng, 1, distinct);
+        (*keys)[i] = value;
+        (*locks)[i] = value;
+    }
+    if (distribution == DIST_DUPLICATES) {
+        for (i = N; i > 1; i--)
+            makeSwap(&(*locks)[i - 1], &(*locks)[randomOffset(&rng, i)]);
+    }
+}
+
+/*
+@brief this function is the benchmark driver. for every distribution it times R runs of matchKeysAndLocksInt on fresh copies of the same input, then makes one more run with the counters on. the counted run uses the portable partition kernel because the AVX2 kernel does not count its moves, the timed runs use the selected kernel. the text format is a table, csv and json give one record per distribution for tracking regressions.
+@param N -> the number of pairs
+@param rounds -> the number of timed runs
+@param distributions -> comma separated names of the distributions
+@param format -> "text", "csv" or "json"
+@return 0 on success, 1 if a name is unknown or a run did not match
+*/
+int runBenchmark(size_t N, int rounds, const char *distributions, const char *format) {
+    int *keys, *locks, *workKeys, *workLocks;
+    int distribution, round, bin, failed = 0;
+    size_t (*timedKernel)(int arr[], size_t n, int pivot, int inclusive) = partitionKernel;
+    uint64_t seed = matcherSeed;
+    char list[256];
+    char *name;
+
+    if (strcmp(format, "text") != 0 && strcmp(format, "csv") != 0 && strcmp(format, "json") != 0) {
+        fprintf(stderr, "unknown format %s\n", format);
+        return 1;
+    }
+    if (strcmp(format, "csv") == 0) {
+        printf("distribution,n,rounds,kernel,seed,mean_s,min_s,max_s,comparisons,swaps,partitions,max_depth,heap_sorts");
+        for (bin = 0; bin < BALANCE_BINS; bin++) printf(",balance_%02d", bin * 5);
+        printf("\n");
+    } else if (strcmp(format, "text") == 0) {
+        printf("N: %zu, rounds: %d, kernel: %s, seed: %llu\n", N, rounds,
+               timedKernel == partitionBlockScalar ? "scalar" : "avx2", (unsigned long long)seed);
+        printf("%-11s %10s %10s %10s %14s %14s %11s %6s %5s\n",
+               "input", "mean s", "min s", "max s", "comparisons", "swaps", "partitions", "depth", "heap");
+    }
+
+    workKeys = (int *)malloc(sizeof(int) * N);
+    workLocks = (int *)malloc(sizeof(int) * N);
+    snprintf(list, sizeof(list), "%s", distributions);
+
+    for (name = strtok(list, ","); name != NULL; name = strtok(NULL, ",")) {
+        MatchStats stats;
+        double total = 0, fastest = 0, slowest = 0;
+
+        for (distribution = 0; distribution < 4; distribution++)
+            if (strcmp(name, distributionNames[distribution]) == 0) break;
+        if (distribution == 4) {
+            fprintf(stderr, "unknown distribution %s\n", name);
+            failed = 1;
+            continue;
+        }
+
+        generatePairs(N, (PairDistribution)distribution, &keys, &locks, 2023u);
+
+        for (round = 0; round < rounds; round++) {
+            double start, elapsed;
+            memcpy(workKeys, keys, sizeof(int) * N);
+            memcpy(workLocks, locks, sizeof(int) * N);
+            setMatcherSeed(seed + (uint64_t)round);
+            start = getTimeInSeconds();
+            matchKeysAndLocksInt(workKeys, workLocks, N);
+            elapsed = getTimeInSeconds() - start;
+            total += elapsed;
+            if (round == 0 || elapsed < fastest) fastest = elapsed;
+            if (round == 0 || elapsed > slowest) slowest = elapsed;
+            if (!isMatched(workKeys, workLocks, N)) failed = 1;
+        }
+
+        memset(&stats, 0, sizeof(stats));
+        memcpy(workKeys, keys, sizeof(int) * N);
+        memcpy(workLocks, locks, sizeof(int) * N);
+        setMatcherSeed(seed);
+        partitionKernel = partitionBlockScalar;
+        activeStats = &stats;
+        matchKeysAndLocksInt(workKeys, workLocks, N);
+        activeStats = NULL;
+        partitionKernel = timedKernel;
+
+        if (strcmp(format, "text") == 0) {
+            printf("%-11s %10.4f %10.4f %10.4f %14llu %14llu %11llu %6d %5llu\n", name, total / rounds, fastest, slowest,
+                   stats.comparisons, stats.swaps, stats.partitions, stats.maxDepth, stats.heapSorts);
+            printf("            balance:");
+            for (bin = 0; bin < BALANCE_BINS; bin++) printf(" %.2f-%.2f:%llu", bin * 0.05, (bin + 1) * 0.05, stats.balance[bin]);
+            printf("\n");
+        } else if (strcmp(format, "csv") == 0) {
+            printf("%s,%zu,%d,%s,%llu,%.6f,%.6f,%.6f,%llu,%llu,%llu,%d,%llu", name, N, rounds,
+                   timedKernel == partitionBlockScalar ? "scalar" : "avx2", (unsigned long long)seed, total / rounds,
+                   fastest, slowest, stats.comparisons, stats.swaps, stats.partitions, stats.maxDepth, stats.heapSorts);
+            for (bin = 0; bin < BALANCE_BINS; bin++) printf(",%llu", stats.balance[bin]);
+            printf("\n");
+        } else {
+            printf("{\"distribution\":\"%s\",\"n\":%zu,\"rounds\":%d,\"kernel\":\"%s\",\"seed\":%llu,"
+                   "\"mean_s\":%.6f,\"min_s\":%.6f,\"max_s\":%.6f,\"comparisons\":%llu,\"swaps\":%llu,"
+                   "\"partitions\":%llu,\"max_depth\":%d,\"heap_sorts\":%llu,\"balance\":[",
+                   name, N, rounds, timedKernel == partitionBlockScalar ? "scalar" : "avx2", (unsigned long long)seed,
+                   total / rounds, fastest, slowest, stats.comparisons, stats.swaps, stats.partitions, stats.maxDepth,
+                   stats.heapSorts);
+            for (bin = 0; bin < BALANCE_BINS; bin++) printf("%s%llu", bin ? "," : "", stats.balance[bin]);
+            printf("]}\n");
+        }
+
+        free(keys);
+        free(locks);
+    }
+
+    setMatcherSeed(seed);
+    free(workKeys);
+    free(workLocks);
+    if (failed) fprintf(stderr, "benchmark failed: unknown distribution or wrong matching\n");
+    return failed;
+}
+
+/*
+@brief this function runs the generated matcher of every key type on n random pairs and prints the time and the keys per second.
+@param n -> the number of pairs
+@return
+*/
+void benchmarkKeyTypes(size_t n) {
+    const char *names[] = {"int", "int64", "128-bit", "bytes"};
+    size_t sizes[] = {sizeof(int), sizeof(int64_t), sizeof(Key128), sizeof(KeyBytes)};
+    int type, correct;
+
+    printf("N: %zu, byte string length: %d\n", n, KEY_BYTES_LENGTH);
+    for (type = 0; type < 4; type++) {
+        double elapsed;
+        if (type == 0) elapsed = benchmarkKeysInt(n, &correct);
+        else if (type == 1) elapsed = benchmarkKeysI64(n, &correct);
+        else if (type == 2) elapsed = benchmarkKeysU128(n, &correct);
+        else elapsed = benchmarkKeysBytes(n, &correct);
+        printf("%-8s (%2zu bytes) %10.4f s %10.2f M pairs/s  %s\n", names[type], sizes[type], elapsed,
+               elapsed > 0 ? n / elapsed / 1e6 : 0.0, correct ? "matched" : "NOT matched");
+    }
+}
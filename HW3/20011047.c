@@ -20,32 +20,346 @@
        - DEBUG ve NORMAL modlarda çalışma yeteneği
 
        Programın sonunda, kullanıcı karma tablonun güncel durumunu görebilir ve yaptığı işlemlerin sonuçlarını inceleyebilir.
+
+       Tablodaki adresler Horner yerine 64 bitlik, 8'er byte okuyan bir hash (wyhash benzeri) ile hesaplanir: hash
+       her isim icin bir kez hesaplanir, h1 ust 32 bitten, h2 alt 32 bitten carpma ile araliga indirgenir (mod yok).
+       Eski Horner hesabi --bench-hash karsilastirmasi ve --bench-layout'taki eski duzen icin tutuluyor.
+
+       Tablo iki ayri diziden olusur: her slot icin 1 byte'lik bir kontrol dizisi (bos, silinmis ya da dolu slotlarda
+       anahtarin hash degerinden 7 bitlik bir parmak izi) ve kullanici adlarinin tutuldugu anahtar dizisi. Bir deneme
+       once sadece kontrol byte'ina bakar, kullanici adina ve karsilastirmaya sadece parmak izi tuttugunda gidilir.
+
+       Anahtar dizisinde isimlerin kendisi degil 16 byte'lik NameRef'ler durur: 11 karaktere kadar isimler dogrudan
+       NameRef'in icinde, daha uzun isimler tablonun isim arenasinda (NameArena, sona ekleyerek buyuyen tek bir blok)
+       tutulur; NameRef'te uzunluk, ilk 8 byte ve arenadaki yer bulunur. Boylece isim uzunlugu sinirsizdir ve
+       buyume, temizlik ve rehash slotlari tasirken isimleri kopyalamaz, sadece NameRef'leri kopyalar (arena eski ve
+       yeni tablo arasinda paylasilir). Arenadaki silinmis isimlerin byte'lari yarisini gecerse bir sonraki yeniden
+       kurulusta aktif isimler yeni bir arenaya kopyalanir.
+
+       Cakisma cozme stratejisi (deneme motoru) derleme sirasinda secilir:
+       - varsayilan: double hashing, her denemede bir slot ((h1 + i*h2) % size)
+       - -DGROUP_PROBING: Swiss table gibi grup denemesi, her adimda 16 kontrol byte'i birden taranir (SSE2 varsa
+         SSE2 ile, yoksa tasinabilir kodla). Gruplar h1'den baslayip 16'sar slot ilerler, boylece tum slotlar gezilir.
+       - -DLINEAR_PROBING: h1, h1 + 1, h1 + 2, ...
+       - -DQUADRATIC_PROBING: h1, h1 + 1, h1 + 3, h1 + 6, ... (h1 + i*(i+1)/2)
+       - -DROBIN_HOOD: linear probing ama kumedeki elemanlar h1'e gore sirali tutulur; kontrol byte'inda parmak izi
+         yerine elemanin h1'ine uzakligi durur, bulunamayan arama kendinden yakin bir elemanda durur. Silme geri
+         kaydirmayla (backward shift) yapilir, silinmis slot olusmaz.
+       - -DCUCKOO_HASHING: her ismin 4'er slotluk iki penceresi vardir (h1 ve h1 + h2'den baslayan), arama en fazla
+         8 slota bakar. Iki pencere de doluysa yer degistirme zinciri (en fazla CUCKOO_MAX_KICKS) aranir.
+       Ilk dort stratejide silinmis slotlar (tombstone) aramayi durdurmaz, arama ilk bos slotta biter; ekleme once
+       ismin tabloda olmadigini gorur ve yolda gordugu ilk silinmis ya da bos slotu kullanir. Her strateji ayni
+       findSlot, slotHasName, placeName ve removeSlot fonksiyonlarini verir, ekleme, silme, arama, buyume ve
+       kayit bunlarin uzerinden calisir. Bir isim yerlestirilemezse (cuckoo zinciri bulunamaz, quadratic dizide yer
+       kalmaz) buyuyen tablo hemen iki katina buyutulur, sabit boyutlu tabloda RESULT_TABLE_FULL dondurulur.
+
+       Tablo kendiliginden buyur: dolu ve silinmis slotlarin orani load factoru (en fazla MAX_GROW_LOAD) gecince
+       bir sonraki asal boyutta yeni bir tablo acilir. Eski tablo bir anda tasinmaz; her ekleme, silme ve aramada
+       eski tablonun en fazla MIGRATE_STEP slotu yeni tabloya aktarilir, tasinma bitene kadar aramalar iki tabloya da
+       bakar. Boylece hicbir ekleme tum tabloyu bastan kurmak zorunda kalmaz. --fixed ile eski sabit boyutlu davranis
+       (en fazla N eleman) secilebilir.
+
+       Silinmis slotlar da ayni yolla temizlenir: silinmis slotlar tablonun COMPACT_RATIO'sunu gecince tablo ayni
+       boyutta (gerekirse daha buyuk) yeniden kurulmaya baslar ve sadece aktif elemanlar kademeli olarak tasinir, tablo
+       bu sirada kullanilmaya devam eder. Grup denemesi motorunda bir slot, cevresinde 16 slotluk dolu bir bolge yoksa
+       hic silinmis isaretlenmeden dogrudan bosaltilir, cunku hicbir arama o slotun uzerinden gecmis olamaz. Menudeki
+       'd' komutu ayni temizligi hemen yapar (eskiden sadece silinmis elemanlari tutuyordu), 'i' komutu silinmis slot
+       oranini, ortalama ve en uzun deneme sayisini ve kac temizlik yapildigini gosterir.
+
+       Komut satiri:
+       - argumansiz                          -> interaktif menu
+       - --bench-layout <N> [load factor]    -> N isim ile eski HashEntry dizisi ve yeni duzenin arama hizini karsilastirir
+       - --bench-grow <N>                    -> kucuk bir tablodan baslayip N isim ekler, kademeli ve tek seferde
+                                                buyumenin toplam suresini ve en yavas eklemeyi karsilastirir
+       - --fixed                             -> interaktif menu, tablo buyumez (eski davranis)
+       - --bench-hash <N>                    -> Horner ve 64 bitlik hash'in hizini ve deneme sayisi dagilimini karsilastirir
+       - --bench-batch <N>                   -> N ismi tek tek ve toplu (insertBatch, searchBatch, deleteBatch) isler
+       - --bench-churn <N>                   -> N elemanli tabloda silme + ekleme dongusu, temizlik acik ve kapaliyken
+                                                silinmis slot oranini ve deneme sayilarini izler
+       - --bench-filter <N>                  -> 0.5 - 0.95 load factor'lerde filtrenin yanlis pozitif oranini ve filtreli /
+                                                filtresiz bulunamayan ve bulunan aramanin suresini olcer
+       - --bench-names <N>                   -> farkli isim uzunlugu dagilimlarinda sabit 30 byte'lik duzen ile arena
+                                                duzeninin eleman basina bellegini ve arama hizini karsilastirir
+       - --open <dosya> [--cow]              -> kayitli tabloyu salt okunur (ya da --cow ile yazilabilir kopya olarak)
+                                                acar ve interaktif menuyu baslatir
+       - --bench-snapshot <N> <dosya>        -> N isimlik tabloyu eklemelerle bastan kurmanin ve kayitli dosyayi mmap
+                                                ile acmanin suresini karsilastirir
+       - --replay <dosya|-> [NORMAL|DEBUG]   -> dosyadaki (ya da "-" ile standart giristeki) komutlari menusuz calistirir;
+                                                her satir "insert|delete|search <isim>" (ya da ekle/sil/ara, e/s/a);
+                                                islem hizini, gecikme yuzdeliklerini ve deneme sayisi dagilimini yazar
+       - --make-log <N>                      -> --replay icin N isimlik anahtar uzayinda ornek bir komut akisi yazar
+       - --bench-strategy <N>                -> derlenen stratejinin 0.5 - 0.95 load factor'lerde islem hizini,
+                                                bellegini ve ortalama / en uzun deneme sayisini olcer
+       - --stress-concurrent <T>             -> eszamanli tabloyu T thread ile zorlar ve sonucu bir modelle dogrular
+       - --bench-concurrent <N> <T>          -> N isimlik eszamanli tabloda 1..T thread ve %99..%50 okuma oranlarinda
+                                                islem hizini olcer
+       - --bench-sharded <N> <T>             -> N ismi 1, 4, 16 ve 64 parcali tabloya 1..T thread ile ekler ve arar
+
+       Toplu islemler (insertBatch, searchBatch, deleteBatch) isimleri BATCH_WINDOW'luk pencerelerle isler: once
+       penceredeki tum isimlerin hash'i hesaplanir ve ilk deneme slotlarinin kontrol byte'i ve anahtari onceden
+       bellege cagirilir (prefetch), sonra isimler sirayla cozulur. Boylece bir ismin cache kacirmasi digerlerinin
+       hash hesabiyla ortusur. Sonuclar ekrana yazilmaz, results dizisine yazilir.
+
+       DEBUG ciktisinin yazilip yazilmayacagi her denemede strcmp ile sorulmaz: mode main'de dogrulandigi icin
+       DEBUG_MODE sadece ilk harfe bakar ve findSlot bunu basta bir kez hesaplar. -DTRACE_ENABLED=0 ile derlenirse
+       DEBUG ciktilari koddan tamamen cikar. --replay komut akisini menusuz calistirir; dosya bir kerede okunur ve
+       yerinde ayristirilir, isimler kopyalanmaz, olcum sadece islemleri kapsar.
+
+       Tablo bir dosyaya kaydedilebilir (menude 'k', writeSnapshot) ve sonra --open ile acilabilir. Dosya bir baslik
+       (surum, deneme motoru, boyut ve sayaclar), kontrol dizisi, NameRef dizisi ve isim arenasindan olusur; bolumler
+       64 byte'a hizalidir. Kayit once ayni dizinde gecici bir dosyaya yazilir, fsync edilir ve rename ile yerine
+       konur, yarim kalan bir kayit eski dosyayi bozmaz. Acilista dosya mmap ile eslenir ve tablo dogrudan eslenen
+       bellegi kullanir, hicbir sey kopyalanmaz ve yeniden eklenmez: salt okunur modda sadece arama yapilabilir,
+       --cow ile acilan tabloda degisiklikler sadece bu surecin sayfalarina yazilir (MAP_PRIVATE), dosya degismez.
+
+       Eszamanli tablo (ConcurrentTable) ayni kontrol + anahtar duzenini kullanir ama boyutu sabittir. Aramalar kilit
+       almaz: kontrol byte'lari atomik okunur, isim karsilastirmasi slotun surum sayaci (seqlock) ile dogrulanir.
+       Ekleme ve silme ismin h1 degerine gore secilen LOCK_STRIPES kilitten birini alir, ayni isim hep ayni kilide
+       duser. Farkli kilitlerdeki yazarlar ayni bos ya da silinmis slotu CAS ile SLOT_BUSY yaparak sahiplenir.
+
+       Aramalarin cogu tabloda olmayan isimler icindir ve bulunamayan bir arama deneme dizisini bos bir slota kadar
+       yurur. Menudeki 'f' komutu tabloya silmeyi destekleyen bir Bloom filtresi (CountingFilter) ekler: her isim
+       filtrenin tek bir 64 byte'lik blogunda FILTER_HASHES tane 4 bitlik sayaci artirir, silinen isim azaltir.
+       Filtre ekleme ve silmeyle birlikte guncellenir; arama ve silme, isim filtrede yoksa tabloya hic bakmadan
+       doner, yani bulunamayan aramalarin cogu tek bir cache satiri okur. Filtre kapasitesini asinca iki kat buyuk
+       yeniden kurulur. Buyume, temizlik ve rehash isimleri tasirken filtre degismez.
+
+       Parcali tablo (ShardedTable) ise buyuyebilen tabloyu cok cekirdekte kullanmak icindir: 2^k ayri HashTable'dan
+       olusur ve her isim 64 bitlik hash'inin ust k bitinin sectigi parcaya gider. Her parcanin kendi kilidi, kendi
+       buyume ve temizlik takvimi vardir; bir parcanin buyumesi digerlerini durdurmaz. Parcalar ayri cache
+       satirlarinda baslar. Parcanin icinde h1 bu k biti atlar (hashShift), yoksa her parca slotlarinin kucuk bir
+       kismini kullanirdi. Durum ve icerik yazdirma (printShardedStats, displayShardedTable) tum parcalari gezer.
 */
 
+#define _POSIX_C_SOURCE 200809L
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <ctype.h>
+#include <time.h>
+#include <limits.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(GROUP_PROBING) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define MAX_NAME_LENGTH 30 // eski sabit boyutlu duzen ve eszamanli tablo icin isim uzunlugu siniri
+#define MAX_INPUT_LENGTH 256 // menude okunan bir ismin en fazla uzunlugu
+#define INLINE_NAME_LENGTH 11 // bu uzunluga kadar isimler arenaya gitmeden NameRef'in icinde tutulur
+#define SLOT_EMPTY 0x80 // bos slotun kontrol byte'i
+#define SLOT_DELETED 0xFE // silinmis slotun kontrol byte'i, dolu slotlarda en yuksek bit 0'dir
+#define GROUP_SIZE 16 // grup denemesinde bir adimda taranan kontrol byte'i sayisi
+#define MIGRATE_STEP 32 // buyume sirasinda her islemde eski tablodan tasinan slot sayisi
+#define MAX_GROW_LOAD 0.9f // load factor bundan buyukse buyume yine bu oranda baslar
+#define MIN_TABLE_SIZE 5 // h2 icin tablo boyutu en az 3 olmali, buyuyen tablolar en az bu boyutta acilir
+#define COMPACT_RATIO 0.25f // silinmis slotlar tablonun bu oranini gecince tablo kademeli olarak yeniden kurulur
+#define SLOT_BUSY 0xFF // eszamanli tabloda bir yazarin sahiplendigi, ismi henuz yazilan slot
+#define LOCK_STRIPES 64 // eszamanli tablodaki yazar kilidi sayisi
+#define BATCH_WINDOW 16 // toplu islemlerde hash'i hesaplanip slotlari onceden bellege cagirilan isim sayisi
+#define PROBE_BUCKETS 17 // komut akisinda deneme sayisi dagilimi 1..16 ve 16'dan fazla olarak tutulur
+#define RH_SATURATED 0x7F // Robin Hood'da bu ve daha buyuk uzakliklar kontrol byte'inda 0x7F olarak tutulur
+#define CUCKOO_WINDOW 4 // cuckoo'da bir ismin iki penceresinin her birindeki slot sayisi
+#define CUCKOO_MAX_KICKS 256 // cuckoo'da bir eklemede yerinden edilebilecek en fazla eleman
+#define MAX_SHARD_BITS 16 // parcali tabloda en fazla 2^16 parca
+#define FILTER_BLOCK_BYTES 64 // filtrede bir ismin tum sayaclari tek bir cache satirindaki 128 sayactan secilir
+#define FILTER_COUNTERS_PER_NAME 10 // filtre boyutlandirilirken isim basina ayrilan 4 bitlik sayac sayisi
+#define FILTER_HASHES 7 // filtrede bir ismin artirdigi sayac sayisi
+#define FILTER_MIN_CAPACITY 1024 // filtre en az bu kadar isme gore boyutlandirilir
+
+// cakisma cozme stratejisi derlemede secilir; hicbiri verilmezse double hashing kullanilir
+#if defined(GROUP_PROBING) + defined(LINEAR_PROBING) + defined(QUADRATIC_PROBING) + defined(ROBIN_HOOD) + defined(CUCKOO_HASHING) > 1
+#error "GROUP_PROBING, LINEAR_PROBING, QUADRATIC_PROBING, ROBIN_HOOD ve CUCKOO_HASHING'den en fazla biri secilebilir"
+#endif
+#if defined(GROUP_PROBING)
+#define PROBE_STRATEGY_ID 1
+#elif defined(LINEAR_PROBING)
+#define PROBE_STRATEGY_ID 2
+#elif defined(QUADRATIC_PROBING)
+#define PROBE_STRATEGY_ID 3
+#elif defined(ROBIN_HOOD)
+#define PROBE_STRATEGY_ID 4
+#elif defined(CUCKOO_HASHING)
+#define PROBE_STRATEGY_ID 5
+#else
+#define PROBE_STRATEGY_ID 0
+#endif
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1 // -DTRACE_ENABLED=0 ile DEBUG ciktilari derlemeden tamamen cikarilir
+#endif
+// mode main'de "NORMAL" ya da "DEBUG" olarak dogrulandigi icin ilk harfe bakmak yeter, her denemede strcmp yapilmaz
+#define DEBUG_MODE(mode) (TRACE_ENABLED && (mode)[0] == 'D')
+#define EMPTY_ENTRY(table, i) ((table)->control[i] == SLOT_EMPTY)
+#define DELETED_ENTRY(table, i) ((table)->control[i] == SLOT_DELETED)
 
-#define MAX_NAME_LENGTH 30
-#define EMPTY_ENTRY(entry) ((entry).userName[0] == '\0')
-#define DELETED_ENTRY(entry) ((entry).deleted)
+#define RESULT_NOT_FOUND -1 // aranan eleman tabloda yok
+#define RESULT_TABLE_FULL -2 // bos ya da silinmis slot kalmadi
+#define RESULT_EXISTS -3 // eklenmek istenen eleman zaten tabloda
+#define RESULT_LIMIT -4 // kullanicinin verdigi N sinirina ulasildi
+#define RESULT_TOO_LONG -5 // isim eszamanli tablonun MAX_NAME_LENGTH'lik slotuna sigmiyor
+#define RESULT_READ_ONLY -6 // tablo salt okunur bir kayittan acildi
 
+#define SNAPSHOT_MAGIC "HW3SNAP" // kayit dosyasinin ilk 8 byte'i ('\0' ile)
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_BYTE_ORDER 0x01020304u // farkli byte sirali bir makinede yazilan dosyayi tanimak icin
+#define SNAPSHOT_ALIGN 64 // dosyadaki bolumlerin hizasi
+#define SNAPSHOT_READ_ONLY 0
+#define SNAPSHOT_COPY_ON_WRITE 1
 
+
+// Eski duzen: kullanici adi ve silinme bilgisi ayni slotta. Sadece --bench-layout karsilastirmasi icin tutuluyor.
 typedef struct {
     char userName[MAX_NAME_LENGTH];
     int deleted;
 } HashEntry;
 
+// uzun isimlerin art arda yazildigi bellek blogu; buyume sirasinda eski ve yeni tablo ayni arenayi kullanir
+typedef struct {
+    char *bytes;
+    size_t used;
+    size_t capacity;
+    size_t deadBytes; // silinmis isimlerin arenada kalan byte'lari
+    int references; // arenayi kullanan tablo sayisi
+    void *mapping; // tablo bir kayittan acildiysa dosyanin eslendigi bellek, arena birakilinca munmap edilir
+    size_t mappingLength;
+    int mappedBytes; // 1 ise bytes eslenen dosyanin icini gosterir, malloc ile alinmamistir
+} NameArena;
+
+// bir slottaki isim: kisa isimler '\0' ile birlikte inlineName'de, uzun isimler arenada durur
+typedef struct {
+    uint32_t length;
+    union {
+        char inlineName[INLINE_NAME_LENGTH + 1];
+        struct {
+            char prefix[8]; // uzun ismin ilk 8 byte'i, arenaya gitmeden eleme icin
+            uint32_t offset; // ismin arenadaki yeri
+        } external;
+    } key;
+} NameRef;
+
+// silmeyi destekleyen Bloom filtresi (counting Bloom filter): her isim ayni bloktaki FILTER_HASHES sayaci artirir
 typedef struct {
-    HashEntry *table;
+    unsigned char *counters; // her byte'ta iki 4 bitlik sayac, FILTER_BLOCK_BYTES'lik bloklar halinde
+    int blockCount;
+    int capacity; // filtrenin boyutlandirildigi isim sayisi, asilinca filtre iki kat buyuk yeniden kurulur
+    int count; // filtredeki isim sayisi
+} CountingFilter;
+
+typedef struct HashTable {
+    unsigned char *control; // her slot icin durum ya da 7 bitlik parmak izi, sonunda GROUP_SIZE - 1 byte'lik ayna
+    NameRef *names; // anahtarlar, kontrol dizisinden ayri tutulur
+    NameArena *arena; // uzun isimlerin byte'lari
     int size;
     float loadFactor;
-    int elementCount;
+    int elementCount; // bos olmayan slot sayisi (aktif + silinmis)
+    int deletedCount; // silinmis slot sayisi
+    int autoResize; // 1 ise tablo kendiliginden buyur, 0 ise en fazla n eleman alir
+    int migrateStep; // her islemde tasinan slot sayisi, olcumde tek seferde tasima icin INT_MAX yapilabilir
+    struct HashTable *previous; // buyume sirasinda tasinmayi bekleyen eski tablo, yoksa NULL
+    int migrateIndex; // eski tabloda tasinacak bir sonraki slot
+    int autoCompact; // 1 ise silinmis slotlar COMPACT_RATIO'yu gecince tablo kendiliginden temizlenir
+    int compactionCount; // bu tablonun kac kez silinmis slotlardan temizlendigi
+    int mapped; // 1 ise control ve names arenanin esledigi kayit dosyasinin icindedir
+    int readOnly; // 1 ise ekleme ve silme RESULT_READ_ONLY dondurur
+    int hashShift; // parcali tabloda parcayi secen ust bit sayisi, h1 bu bitlerden sonra baslar; tek tabloda 0
+    CountingFilter *filter; // NULL degilse tablodaki isimlerin filtresi, filtrede olmayan isim tabloda aranmaz
 } HashTable;
 
+// kayit dosyasinin basligi, bolumlerin yerleri dosyanin basina gore
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t engine; // PROBE_STRATEGY_ID; slotlarin yeri ve kontrol byte'larinin anlami stratejiye bagli
+    uint32_t nameRefSize;
+    int32_t size;
+    int32_t elementCount;
+    int32_t deletedCount;
+    int32_t compactionCount;
+    float loadFactor;
+    uint32_t reserved;
+    uint64_t controlOffset;
+    uint64_t controlLength;
+    uint64_t namesOffset;
+    uint64_t arenaOffset;
+    uint64_t arenaLength;
+    uint64_t arenaDeadBytes;
+    uint64_t fileLength;
+} SnapshotHeader;
+
+// tablonun durumunu ozetleyen sayilar, 'i' komutu ve olcumler icin
+typedef struct {
+    int liveCount;
+    int tombstoneCount;
+    int pendingCount; // buyume ya da temizlik sirasinda eski tabloda tasinmayi bekleyen aktif eleman sayisi
+    double tombstoneRatio; // silinmis slot sayisi / tablo boyutu
+    double meanProbe; // aktif elemanlarin bulunmasi icin bakilan ortalama slot (grup motorunda grup) sayisi
+    long long maxProbe;
+    int compactionCount;
+} TableStats;
+
+// bir kullanici adinin deneme dizisi icin gereken degerler
+typedef struct {
+    int h1Value;
+    int h2Value;
+    unsigned char fingerprint;
+    int length; // ismin uzunlugu, karsilastirmalarda strlen tekrar hesaplanmasin diye
+    uint64_t value; // 64 bitlik hash degerinin kendisi, filtre sayaclari bundan secilir
+} SlotHash;
+
+// toplu islemin turu
+typedef enum {
+    BATCH_INSERT,
+    BATCH_SEARCH,
+    BATCH_DELETE
+} BatchOperation;
+
+// komut akisindan okunan bir islem; name okunan tamponun icini gosterir
+typedef struct {
+    BatchOperation operation;
+    char *name;
+} ReplayCommand;
+
+// her kilit ayri bir cache satirinda durur, farkli kilitleri alan thread'ler birbirini yavaslatmaz
+typedef struct {
+    _Alignas(64) pthread_mutex_t lock;
+} LockStripe;
+
+// birden fazla thread'in ayni anda kullanabildigi sabit boyutlu tablo
+typedef struct {
+    _Atomic unsigned char *control; // SLOT_EMPTY, SLOT_DELETED, SLOT_BUSY ya da parmak izi
+    _Atomic unsigned int *version; // slotun ismi yazilirken tek, diger zamanlarda cift
+    char (*userNames)[MAX_NAME_LENGTH];
+    int size;
+    atomic_int liveCount;
+    LockStripe stripes[LOCK_STRIPES];
+} ConcurrentTable;
+
+// parcali tablonun bir parcasi: kendi kilidi ve kendi buyume / temizlik durumu olan siradan bir HashTable.
+// Her parca ayri cache satirlarindan baslar, bir parcanin kilidi ve sayaclari komsu parcayla ayni satiri paylasmaz.
+typedef struct {
+    _Alignas(64) pthread_mutex_t lock;
+    HashTable table;
+} TableShard;
+
+// 2^shardBits parcadan olusan tablo, parca ismin 64 bitlik hash'inin ust shardBits bitiyle secilir
+typedef struct {
+    int shardBits;
+    int shardCount;
+    TableShard *shards;
+} ShardedTable;
+
+// olcumlerde findSlot'un baktigi slot (grup motorunda grup) sayisi, sadece NULL degilse sayilir
+static long long *activeProbeCount = NULL;
+
 // Fonksiyon prototipleri, aşağıda detaylı olarak açıklanmıştır
 unsigned long hornerHash(char *str, int tableSize);
 int isPrime(int num);
@@ -56,12 +370,80 @@ int hasDeletedEntry(HashTable *table);
 HashTable createHashTable(int size, float loadFactor);
 void freeHashTable(HashTable *table);
 void displayHashTable(HashTable *table);
-int findSlot(HashTable *table, char *userName, char *mode, int h1Value, int h2Value);
+uint64_t wordHash(const char *userName, size_t length);
+NameArena *createArena(void);
+void releaseArena(NameArena *arena);
+NameRef storeName(NameArena *arena, const char *userName, int length);
+const char *nameAt(HashTable *table, int index);
+int nameEquals(HashTable *table, int index, const char *userName, int length);
+void benchmarkNames(int n);
+int writeSnapshot(HashTable *table, const char *path);
+int openSnapshot(const char *path, int openMode, HashTable *table);
+void benchmarkSnapshot(int n, const char *path);
+int replayCommands(const char *path, char *mode);
+void generateCommandLog(int n);
+void benchmarkStrategy(int n);
+SlotHash computeSlotHash(char *userName, int tableSize);
+SlotHash slotHashFromValue(uint64_t value, int length, int tableSize, int hashShift);
+SlotHash tableSlotHash(HashTable *table, char *userName);
+CountingFilter *createFilter(int capacity);
+void freeFilter(CountingFilter *filter);
+void filterAdd(CountingFilter *filter, uint64_t value);
+void filterRemove(CountingFilter *filter, uint64_t value);
+int filterMayContain(CountingFilter *filter, uint64_t value);
+void buildFilter(HashTable *table);
+void toggleFilter(HashTable *table);
+void benchmarkFilter(int n);
+SlotHash hornerSlotHash(char *userName, int tableSize);
+void benchmarkHash(int n);
+void setControl(HashTable *table, int index, unsigned char value);
+void inheritSettings(HashTable *to, HashTable *from);
+int growThreshold(HashTable *table);
+void startResize(HashTable *table, char *mode, int grow);
+TableStats computeTableStats(HashTable *table);
+void printTableStats(HashTable *table);
+void benchmarkChurn(int n);
+void migrateStep(HashTable *table);
+void finishMigration(HashTable *table);
+int takeFromPrevious(HashTable *table, char *userName);
+void benchmarkGrowth(int n);
+ConcurrentTable *createConcurrentTable(int size);
+void freeConcurrentTable(ConcurrentTable *table);
+int concurrentInsert(ConcurrentTable *table, char *userName);
+int concurrentDelete(ConcurrentTable *table, char *userName);
+int concurrentSearch(ConcurrentTable *table, char *userName);
+int stressConcurrent(int threadCount);
+void benchmarkConcurrent(int n, int maxThreads);
+ShardedTable *createShardedTable(int shardBits, int n, float loadFactor);
+void freeShardedTable(ShardedTable *table);
+int shardedInsert(ShardedTable *table, char *userName);
+int shardedDelete(ShardedTable *table, char *userName);
+int shardedSearch(ShardedTable *table, char *userName);
+TableStats computeShardedStats(ShardedTable *table);
+void printShardedStats(ShardedTable *table);
+void displayShardedTable(ShardedTable *table);
+void benchmarkSharded(int n, int maxThreads);
+const char *probeEngineName(void);
+int findSlot(HashTable *table, char *userName, char *mode, SlotHash hash);
+int insertName(HashTable *table, char *userName, char *mode, int n);
+int deleteName(HashTable *table, char *userName, char *mode);
+int searchName(HashTable *table, char *userName, char *mode);
+int insertNameHashed(HashTable *table, char *userName, char *mode, int n, SlotHash hash);
+int deleteNameHashed(HashTable *table, char *userName, char *mode, SlotHash hash);
+int searchNameHashed(HashTable *table, char *userName, char *mode, SlotHash hash);
+void insertBatch(HashTable *table, char **userNames, int count, int n, int *results);
+void searchBatch(HashTable *table, char **userNames, int count, int *results);
+void deleteBatch(HashTable *table, char **userNames, int count, int *results);
+void benchmarkBatch(int n);
 void insertEntry(HashTable *table, char *userName, char *mode, int n);
 void deleteEntry(HashTable *table, char *userName, char *mode);
-HashEntry *searchEntry(HashTable *table, char *userName, char *mode);
+const char *searchEntry(HashTable *table, char *userName, char *mode);
 void rehash(HashTable *table, char *mode);
 void reorganizeTable(HashTable *table, char *mode);
+double getTimeInSeconds(void);
+void makeUserName(char *buffer, unsigned long long i);
+int legacyFindSlot(HashEntry *entries, int size, char *userName);
+void benchmarkLayout(int n, float loadFactor);
 
 /*
 @brief Bu fonksiyon, bir string degrini alıp ona Horner Kuralı uygular bu metnin degerini hesaplar
@@ -139,13 +521,7 @@ int h2(unsigned long key, int tableSize) {
 @return Silinmiş bir giriş varsa 1, yoksa 0 döndürür
 */
 int hasDeletedEntry(HashTable *table) {
-    int i;
-    for (i = 0; i < table->size; i++) {
-        if (DELETED_ENTRY(table->table[i])) {
-            return 1;
-        }
-    }
-    return 0;
+    return memchr(table->control, SLOT_DELETED, table->size) != NULL;
 }
 
 /*
@@ -159,7 +535,22 @@ HashTable createHashTable(int size, float loadFactor) {
     table.size = size;
     table.loadFactor = loadFactor;
     table.elementCount = 0;
-    table.table = (HashEntry *)calloc(size, sizeof(HashEntry));
+    table.deletedCount = 0;
+    table.autoResize = 1;
+    table.migrateStep = MIGRATE_STEP;
+    table.previous = NULL;
+    table.migrateIndex = 0;
+    table.autoCompact = 1;
+    table.compactionCount = 0;
+    // sondaki ayna byte'lari sayesinde tablonun sonundan baslayan bir grup da tek seferde okunabilir
+    table.control = (unsigned char *)malloc(size + GROUP_SIZE - 1);
+    memset(table.control, SLOT_EMPTY, size + GROUP_SIZE - 1);
+    table.names = (NameRef *)calloc((size_t)size, sizeof(NameRef)); // bos slotlar kayit dosyasina sifir olarak yazilir
+    table.mapped = 0;
+    table.readOnly = 0;
+    table.hashShift = 0;
+    table.filter = NULL;
+    table.arena = createArena();
     return table;
 }
 
@@ -168,10 +559,26 @@ HashTable createHashTable(int size, float loadFactor) {
 @param table -> Serbest bırakılacak hash tablosu
 */
 void freeHashTable(HashTable *table) {
-    free(table->table);
-    table->table = NULL;
+    if (table->previous != NULL) {
+        freeHashTable(table->previous);
+        free(table->previous);
+        table->previous = NULL;
+    }
+    if (!table->mapped) {
+        free(table->control);
+        free(table->names);
+    }
+    releaseArena(table->arena);
+    if (table->filter != NULL) {
+        freeFilter(table->filter);
+        table->filter = NULL;
+    }
+    table->control = NULL;
+    table->names = NULL;
+    table->arena = NULL;
     table->size = 0;
     table->elementCount = 0;
+    table->deletedCount = 0;
 }
 
 /*
@@ -183,302 +590,3683 @@ void displayHashTable(HashTable *table) {
     printf("Hash Tablosu İcerigi:\n");
     int i;
     for ( i = 0; i < table->size; i++) {
-        if (!EMPTY_ENTRY(table->table[i])) {
+        if (!EMPTY_ENTRY(table, i)) {
             printf("Adres: %d, kullanici adi: %s, Durum: %s\n",
                    i,
-                   table->table[i].userName,
-                   DELETED_ENTRY(table->table[i]) ? "Silinmis" : "Aktif");
+                   nameAt(table, i),
+                   DELETED_ENTRY(table, i) ? "Silinmis" : "Aktif");
+        }
+    }
+    if (table->previous != NULL) {
+        printf("Tasinmayi bekleyen eski tablo (boyut %d):\n", table->previous->size);
+        for (i = table->migrateIndex; i < table->previous->size; i++) {
+            if (!EMPTY_ENTRY(table->previous, i) && !DELETED_ENTRY(table->previous, i)) {
+                printf("Eski Adres: %d, kullanici adi: %s, Durum: Aktif\n", i, nameAt(table->previous, i));
+            }
         }
     }
 }
 
 /*
-@brief Bu fonksiyon, verilen kullanıcı adı için hash tablosunda uygun bir yuva (slot) bulur.
-@param table -> Arama yapılacak hash tablosu
-@param userName -> Aranacak kullanıcı adı
-@param mode -> Çalışma modu (DEBUG veya NORMAL)
-@param h1Value -> Birincil karma değeri
-@param h2Value -> İkincil karma değeri
-@return Bulunan yuva indeksi veya -1
+@brief Bu fonksiyon, iki 64 bitlik sayiyi 128 bitlik carpar ve carpimin iki yarisini XOR'lar (wyhash'in karistirma adimi).
+@param a -> birinci sayi
+@param b -> ikinci sayi
+@return karistirilmis deger
 */
-int findSlot(HashTable *table, char *userName, char *mode, int h1Value, int h2Value) {
-    int index;
-    int i;
+static uint64_t hashMix(uint64_t a, uint64_t b) {
+    __uint128_t product = (__uint128_t)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+}
 
-    if (strcmp(mode, "DEBUG") == 0) {
-        printf("h1(%s) = %d\n", userName, h1Value);
-        printf("h2(%s) = %d\n", userName, h2Value);
-    }
+/*
+@brief Bu fonksiyon, bellekten hizalanmamis 8 byte'lik bir kelime okur.
+@param p -> okunacak adres
+@return okunan kelime
+*/
+static uint64_t readWord64(const unsigned char *p) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
 
-    for (i = 0; i < table->size; i++) {
-        index = (h1Value + i * h2Value) % table->size;
+/*
+@brief Bu fonksiyon, readWord64'un 4 byte'lik surumudur.
+@param p -> okunacak adres
+@return okunan kelime
+*/
+static uint64_t readWord32(const unsigned char *p) {
+    uint32_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
 
-        if (strcmp(mode, "DEBUG") == 0) {
-            printf("Deneme %d: Adres: %d\n", i + 1, index);
-        }
+/*
+@brief Bu fonksiyon, kullanici adinin 64 bitlik hash degerini hesaplar. Isim 8'er byte'lik kelimeler halinde okunur (wyhash'in kisa anahtar yolu): 16 byte'tan uzun kisimlar once tek bir carpmayla karistirilir, kalan 1-16 byte ust uste binen iki okumayla alinir. Karakter basina bolme ya da mod yoktur.
+@param userName -> kullanici adi
+@param length -> ismin uzunlugu
+@return 64 bitlik hash degeri
+*/
+uint64_t wordHash(const char *userName, size_t length) {
+    static const uint64_t secret0 = 0xa0761d6478bd642fULL, secret1 = 0xe7037ed1a0b428dbULL;
+    const unsigned char *p = (const unsigned char *)userName;
+    size_t remaining = length;
+    uint64_t seed = secret0 ^ length, a = 0, b = 0;
 
-        if (EMPTY_ENTRY(table->table[index]) || DELETED_ENTRY(table->table[index]) || strcmp(table->table[index].userName, userName) == 0) {
-            if (strcmp(mode, "DEBUG") == 0) {
-                printf("%s kelimesi %d. adreste %s.\n", userName, index, EMPTY_ENTRY(table->table[index]) || DELETED_ENTRY(table->table[index]) ? "bulunamadı" : "bulundu");
-            }
-            return index;
-        }
+    while (remaining > 16) {
+        seed = hashMix(readWord64(p) ^ secret1, readWord64(p + 8) ^ seed);
+        p += 16;
+        remaining -= 16;
     }
-    return -1;
+    if (remaining >= 8) {
+        a = readWord64(p);
+        b = readWord64(p + remaining - 8);
+    } else if (remaining >= 4) {
+        a = readWord32(p) << 32 | readWord32(p + remaining - 4);
+    } else if (remaining > 0) {
+        a = (uint64_t)p[0] << 16 | (uint64_t)p[remaining >> 1] << 8 | p[remaining - 1];
+    }
+    return hashMix(secret1 ^ length, hashMix(a ^ secret1, b ^ seed));
 }
 
 /*
-@brief Bu fonksiyon, hash tablosuna yeni bir giriş ekler.
-@param table -> Ekleme yapılacak hash tablosu
-@param userName -> Eklenecek kullanıcı adı
-@param mode -> Çalışma modu (DEBUG veya NORMAL)
-@param n -> Maksimum eleman sayısı
+@brief Bu fonksiyon, bir kullanici adi icin h1, h2 ve parmak izini bir kerede hesaplar. 64 bitlik hash bir kere hesaplanir; h1 ust 32 bitten [0, size), h2 alt 32 bitten [1, size - 1] araligina carpma ile indirgenir (x * size >> 32), parmak izi h2'nin neredeyse hic kullanmadigi en alttaki 7 bittir. Tablo boyutu asal oldugu icin her h2 tum slotlari gezer.
+@param userName -> kullanici adi
+@param tableSize -> hash tablosunun boyutu
+@return hesaplanan degerler
 */
-void insertEntry(HashTable *table, char *userName, char *mode, int n) {
-    unsigned long key = hornerHash(userName, table->size);
-    int h1Value = h1(key, table->size);
-    int h2Value = h2(key, table->size);
+SlotHash computeSlotHash(char *userName, int tableSize) {
+    size_t length = strlen(userName);
+    return slotHashFromValue(wordHash(userName, length), (int)length, tableSize, 0);
+}
 
-    if (table->elementCount >= n) {
-        printf("Tabloya %d kadar eleman girdiniz. Tekrar ekleme yapamazsiniz.\n", n);
-        return;
-    }
+/*
+@brief Bu fonksiyon, hesaplanmis 64 bitlik hash degerinden h1, h2 ve parmak izini cikarir. Parcali tabloda ust hashShift bit parcayi sectigi icin bir parcadaki tum isimlerde aynidir; h1 bu bitleri atlayip sonraki 32 bitten hesaplanir, yoksa her parca slotlarinin sadece 1/2^hashShift'ini kullanirdi.
+@param value -> wordHash degeri
+@param length -> ismin uzunlugu
+@param tableSize -> hash tablosunun boyutu
+@param hashShift -> h1'den once atlanacak ust bit sayisi (0 - 31)
+@return hesaplanan degerler
+*/
+SlotHash slotHashFromValue(uint64_t value, int length, int tableSize, int hashShift) {
+    SlotHash hash;
+    uint64_t high = (value << hashShift) >> 32, low = value & 0xFFFFFFFFULL;
 
-    int index = findSlot(table, userName, mode, h1Value, h2Value);
+    hash.h1Value = (int)((high * (uint64_t)tableSize) >> 32);
+    hash.h2Value = 1 + (int)((low * (uint64_t)(tableSize > 1 ? tableSize - 1 : 1)) >> 32);
+    hash.fingerprint = (unsigned char)(value & 0x7F);
+    hash.length = length;
+    hash.value = value;
+    return hash;
+}
 
+/*
+@brief Bu fonksiyon, bir ismin verilen tablodaki hash degerlerini tablonun su anki boyutu ve hashShift'i ile hesaplar.
+@param table -> hash tablosu
+@param userName -> kullanici adi
+@return hesaplanan degerler
+*/
+SlotHash tableSlotHash(HashTable *table, char *userName) {
+    size_t length = strlen(userName);
+    return slotHashFromValue(wordHash(userName, length), (int)length, table->size, table->hashShift);
+}
 
-    if (index == -1) {
-        printf("Tablo dolu, daha fazla eleman ekleyemezsiniz.\n");
-        return;
-    }
+/*
+@brief Bu fonksiyon, en az capacity isim icin boyutlandirilmis bos bir filtre olusturur. Isim basina FILTER_COUNTERS_PER_NAME sayac ayrilir; bloklar cache satirina hizalidir.
+@param capacity -> filtrenin boyutlandirilacagi isim sayisi
+@return olusturulan filtre
+*/
+CountingFilter *createFilter(int capacity) {
+    CountingFilter *filter = (CountingFilter *)malloc(sizeof(CountingFilter));
+    long long counters;
 
-    if (EMPTY_ENTRY(table->table[index]) || DELETED_ENTRY(table->table[index])) {
-        strcpy(table->table[index].userName, userName);
-        table->table[index].deleted = 0;
-        table->elementCount++;
-        printf("Elemaniniz %d. adrese yerlestirildi.\n", index);
-    } else {
-        printf("Eleman tabloda mevcut oldugu icin ekleme islemi yapilmadi\n");
-    }
+    if (capacity < FILTER_MIN_CAPACITY) capacity = FILTER_MIN_CAPACITY;
+    counters = (long long)capacity * FILTER_COUNTERS_PER_NAME;
+    filter->blockCount = (int)((counters + 2 * FILTER_BLOCK_BYTES - 1) / (2 * FILTER_BLOCK_BYTES));
+    filter->capacity = capacity;
+    filter->count = 0;
+    filter->counters = (unsigned char *)aligned_alloc(FILTER_BLOCK_BYTES, (size_t)filter->blockCount * FILTER_BLOCK_BYTES);
+    memset(filter->counters, 0, (size_t)filter->blockCount * FILTER_BLOCK_BYTES);
+    return filter;
 }
 
 /*
-@brief Bu fonksiyon, hash tablosundan bir girişi siler.
-@param table -> Silme işlemi yapılacak hash tablosu
-@param userName -> Silinecek kullanıcı adı
-@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@brief Bu fonksiyon, filtreyi free eder.
+@param filter -> filtre
 */
-void deleteEntry(HashTable *table, char *userName, char *mode) {
-    unsigned long key = hornerHash(userName, table->size);
-    int h1Value = h1(key, table->size);
-    int h2Value = h2(key, table->size);
+void freeFilter(CountingFilter *filter) {
+    free(filter->counters);
+    free(filter);
+}
 
-    int index = findSlot(table, userName, mode, h1Value, h2Value);
+/*
+@brief Bu fonksiyon, bir ismin filtredeki blogunu ve bloktaki sayaclarin dizisini secer. Hash degeri tablonun kullandigi bitlerden bagimsiz olsun diye bir kez daha karistirilir; ust 32 bit blogu, alt bitler bloktaki 128 sayactan ilkini ve adimi secer. Adim tek oldugu icin FILTER_HASHES sayacin hepsi farklidir.
+@param filter -> filtre
+@param value -> ismin 64 bitlik hash degeri
+@param first -> bloktaki ilk sayac buraya yazilir
+@param step -> sayaclar arasindaki adim buraya yazilir
+@return ismin blogu
+*/
+static unsigned char *filterBlock(CountingFilter *filter, uint64_t value, unsigned int *first, unsigned int *step) {
+    uint64_t mixed = hashMix(value ^ 0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL);
 
-    if (!EMPTY_ENTRY(table->table[index]) && !DELETED_ENTRY(table->table[index])) {
-        table->table[index].deleted = 1;
-        printf("%d adresindeki %s elemani silindi.\n", index, userName);
-    } else {
-        printf("%s elemani tabloda bulunmuyor.\n", userName);
-    }
+    *first = (unsigned int)(mixed & 127);
+    *step = (unsigned int)((mixed >> 7) & 127) | 1;
+    return filter->counters + (((mixed >> 32) * (uint64_t)filter->blockCount) >> 32) * FILTER_BLOCK_BYTES;
 }
 
 /*
-@brief Bu fonksiyon, hash tablosunda belirtilen kullanıcı adını arar.
-@param table -> Arama yapılacak hash tablosu
-@param userName -> Aranacak kullanıcı adı
-@param mode -> Çalışma modu (DEBUG veya NORMAL)
-@return Bulunan HashEntry nesnesinin adresi veya NULL
+@brief Bu fonksiyon, bir ismi filtreye ekler: ismin sayaclari birer artirilir. 15'e ulasan sayac bir daha degismez (doymus sayac), boylece azaltilirken yanlis negatif olusmaz.
+@param filter -> filtre
+@param value -> ismin 64 bitlik hash degeri
 */
-HashEntry *searchEntry(HashTable *table, char *userName, char *mode) {
-    unsigned long key = hornerHash(userName, table->size);
-    int h1Value = h1(key, table->size);
-    int h2Value = h2(key, table->size);
+void filterAdd(CountingFilter *filter, uint64_t value) {
+    unsigned int first, step, i;
+    unsigned char *block = filterBlock(filter, value, &first, &step);
 
-    int index = findSlot(table, userName, mode, h1Value, h2Value);
-    if (!EMPTY_ENTRY(table->table[index]) && !DELETED_ENTRY(table->table[index])) {
-        printf("%s elemani %d adresinde bulunuyor.\n", userName, index);
-        return &table->table[index];
-    } else {
-        printf("%s elemani tabloda bulunamadi.\n", userName);
-        return NULL;
+    for (i = 0; i < FILTER_HASHES; i++) {
+        unsigned int counter = (first + i * step) & 127, shift = (counter & 1) * 4;
+        if (((block[counter >> 1] >> shift) & 15) != 15) block[counter >> 1] += (unsigned char)(1 << shift);
     }
+    filter->count++;
 }
 
 /*
-@brief Bu fonksiyon, hash tablosunu yeniden düzenler (rehash).
-@param table -> Yeniden düzenlenecek hash tablosu
-@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@brief Bu fonksiyon, tablodan silinen bir ismi filtreden cikarir: ismin doymamis sayaclari birer azaltilir. Isim filtreye daha once eklenmis olmalidir.
+@param filter -> filtre
+@param value -> ismin 64 bitlik hash degeri
 */
-void rehash(HashTable *table, char *mode) {
-    int i;
-    int oldSize = table->size;
-    HashEntry *oldTable = table->table;
+void filterRemove(CountingFilter *filter, uint64_t value) {
+    unsigned int first, step, i;
+    unsigned char *block = filterBlock(filter, value, &first, &step);
 
-    // Aynı boyutta yeni bir tablo oluştur
-    HashEntry *newTable = (HashEntry *)calloc(oldSize, sizeof(HashEntry));
-    HashTable tempTable;
-    tempTable.table = newTable;
-    tempTable.size = oldSize;
-    tempTable.elementCount = 0;  // Yeni tablonun eleman sayısını sıfırla
+    for (i = 0; i < FILTER_HASHES; i++) {
+        unsigned int counter = (first + i * step) & 127, shift = (counter & 1) * 4;
+        unsigned int current = (block[counter >> 1] >> shift) & 15;
+        if (current != 15 && current != 0) block[counter >> 1] -= (unsigned char)(1 << shift);
+    }
+    filter->count--;
+}
 
+/*
+@brief Bu fonksiyon, ismin filtrede olup olmadigina bakar. Sayaclardan biri 0 ise isim kesinlikle tabloda yoktur; hepsi 0'dan buyukse isim tabloda olabilir (yanlis pozitif). Sadece tek bir cache satiri okunur.
+@param filter -> filtre
+@param value -> ismin 64 bitlik hash degeri
+@return isim tabloda olabilirse 1, kesinlikle yoksa 0
+*/
+int filterMayContain(CountingFilter *filter, uint64_t value) {
+    unsigned int first, step, i;
+    unsigned char *block = filterBlock(filter, value, &first, &step);
 
-    for (i = 0; i < oldSize; i++) {
-        if (!EMPTY_ENTRY(oldTable[i]) && !DELETED_ENTRY(oldTable[i])) {
-            unsigned long key = hornerHash(oldTable[i].userName, oldSize);
-            int h1Value = h1(key, oldSize);
-            int h2Value = h2(key, oldSize);
+    for (i = 0; i < FILTER_HASHES; i++) {
+        unsigned int counter = (first + i * step) & 127;
+        if (((block[counter >> 1] >> ((counter & 1) * 4)) & 15) == 0) return 0;
+    }
+    return 1;
+}
 
-            // Eski tablodaki eleman için yeni adresi bul
-            int newIndex = findSlot(&tempTable, oldTable[i].userName, mode, h1Value, h2Value);
-            newTable[newIndex] = oldTable[i];
+/*
+@brief Bu fonksiyon, tablonun filtresini (varsa eskisini atarak) tablodaki ve tasinmayi bekleyen tum aktif isimlerden yeniden kurar. Filtre aktif isim sayisinin iki katina gore boyutlandirilir; ekleme filtrenin kapasitesini asinca bu fonksiyonu tekrar cagirir.
+@param table -> hash tablosu
+*/
+void buildFilter(HashTable *table) {
+    HashTable *previous = table->previous;
+    int live = table->elementCount - table->deletedCount, i;
 
-            if (strcmp(mode, "DEBUG") == 0) {
-                printf("Rehash: Eski Adres: %d, Yeni Adres: %d, Kullanici: %s\n", i, newIndex, oldTable[i].userName);
+    if (previous != NULL) live += previous->elementCount - previous->deletedCount;
+    if (table->filter != NULL) freeFilter(table->filter);
+    table->filter = createFilter(2 * live);
+    for (i = 0; i < table->size; i++) {
+        if (!EMPTY_ENTRY(table, i) && !DELETED_ENTRY(table, i)) {
+            filterAdd(table->filter, wordHash(nameAt(table, i), table->names[i].length));
+        }
+    }
+    if (previous != NULL) {
+        for (i = table->migrateIndex; i < previous->size; i++) {
+            if (!EMPTY_ENTRY(previous, i) && !DELETED_ENTRY(previous, i)) {
+                filterAdd(table->filter, wordHash(nameAt(previous, i), previous->names[i].length));
             }
-
-            // Yeni tablonun eleman sayısını güncelle
-            tempTable.elementCount++;
         }
     }
-
-    // Eski tabloyu serbest bırak ve yeni tabloyu atama
-    free(oldTable);
-    table->table = newTable;
-    table->elementCount = tempTable.elementCount;
 }
 
 /*
-@brief Bu fonksiyon, hash tablosunu düzenler, silinmiş girişleri yeni bir tabloya taşır.
-@param table -> Düzenlenecek hash tablosu
-@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@brief Bu fonksiyon, menudeki 'f' komutudur: tabloda filtre yoksa tablonun isimlerinden kurar, varsa kaldirir. Filtre sadece bellekte tutulur, kayit dosyasina yazilmaz; salt okunur acilan tabloda da kurulabilir.
+@param table -> hash tablosu
 */
-void reorganizeTable(HashTable *table, char *mode) {
-    if (table->elementCount == 0) {
-        printf("Tablo bos, eleman ekleyip silmeden duzenleme yapilamaz.\n");
+void toggleFilter(HashTable *table) {
+    if (table->filter != NULL) {
+        freeFilter(table->filter);
+        table->filter = NULL;
+        printf("Filtre kaldirildi.\n");
         return;
     }
+    buildFilter(table);
+    printf("Filtre kuruldu: %d isim, %d KB.\n", table->filter->count,
+           table->filter->blockCount * FILTER_BLOCK_BYTES / 1024);
+}
 
-    if (!hasDeletedEntry(table)) {
-        printf("Tabloda silinmis eleman yok. once eleman silin ve sonra duzenleyin.\n");
-        return;
+/*
+@brief Bu fonksiyon, computeSlotHash'in eski Horner surumudur, sadece --bench-hash karsilastirmasi icin tutuluyor. Horner degeri (hornerHash ile ayni) ve Horner'dan bagimsiz olmasi icin FNV-1a ile 7 bitlik parmak izi ayni dongude hesaplanir, isim bir kere okunur.
+@param userName -> kullanici adi
+@param tableSize -> hash tablosunun boyutu
+@return hesaplanan degerler
+*/
+SlotHash hornerSlotHash(char *userName, int tableSize) {
+    SlotHash hash;
+    unsigned long key = 0;
+    unsigned int fnv = 2166136261u;
+    int i;
+
+    for (i = 0; userName[i] != '\0'; i++) {
+        key = (key * 31 + userName[i]) % tableSize;
+        fnv = (fnv ^ (unsigned char)userName[i]) * 16777619u;
     }
+    hash.h1Value = h1(key, tableSize);
+    hash.h2Value = h2(key, tableSize);
+    hash.fingerprint = (unsigned char)(fnv >> 25);
+    hash.length = i;
+    hash.value = 0; // filtre sadece 64 bitlik hash ile kullanilir
+    return hash;
+}
 
-    // Yeni tablo oluştur
-    HashTable newTable = createHashTable(table->size, table->loadFactor);
-    int i;
-    for (i = 0; i < table->size; i++) {
-        if (DELETED_ENTRY(table->table[i])) {
-            unsigned long key = hornerHash(table->table[i].userName, table->size);
-            int h1Value = h1(key, table->size);
-            int h2Value = h2(key, table->size);
+/*
+@brief Bu fonksiyon, bir slotun kontrol byte'ini yazar, slot tablonun basindaysa sondaki ayna byte'larini da gunceller.
+@param table -> hash tablosu
+@param index -> slotun adresi
+@param value -> SLOT_EMPTY, SLOT_DELETED ya da parmak izi
+*/
+void setControl(HashTable *table, int index, unsigned char value) {
+    int mirror;
+    table->control[index] = value;
+    for (mirror = index + table->size; mirror < table->size + GROUP_SIZE - 1; mirror += table->size) {
+        table->control[mirror] = value;
+    }
+}
 
-            int newIndex = findSlot(&newTable, table->table[i].userName, mode, h1Value, h2Value);
-            strcpy(newTable.table[newIndex].userName, table->table[i].userName);
-            newTable.table[newIndex].deleted = 1; // Taşınan eleman silinmis olarak işaretlenmeli
-            newTable.elementCount++;
+/*
+@brief Bu fonksiyon, bos bir isim arenasi olusturur; bellek ilk uzun isim yazilinca alinir.
+@return arena, tek bir tablo tarafindan kullaniliyor
+*/
+NameArena *createArena(void) {
+    NameArena *arena = (NameArena *)malloc(sizeof(NameArena));
+    arena->bytes = NULL;
+    arena->used = 0;
+    arena->capacity = 0;
+    arena->deadBytes = 0;
+    arena->references = 1;
+    arena->mapping = NULL;
+    arena->mappingLength = 0;
+    arena->mappedBytes = 0;
+    return arena;
+}
 
-            if (strcmp(mode, "DEBUG") == 0) {
-                printf("Duzenleme: Eski Adres: %d, Yeni Adres: %d, Kullanici: %s\n", i, newIndex, table->table[i].userName);
-            }
+/*
+@brief Bu fonksiyon, bir tablonun arenayi birakmasidir; arenayi kullanan son tablo da biraktiysa arena serbest birakilir.
+@param arena -> birakilacak arena, NULL olabilir
+*/
+void releaseArena(NameArena *arena) {
+    if (arena == NULL || --arena->references > 0) return;
+    if (!arena->mappedBytes) free(arena->bytes);
+    if (arena->mapping != NULL) munmap(arena->mapping, arena->mappingLength);
+    free(arena);
+}
+
+/*
+@brief Bu fonksiyon, bir ismin NameRef'ini olusturur. Kisa isimler NameRef'in icine kopyalanir, uzun isimler '\0' ile birlikte arenanin sonuna eklenir; arena dolarsa iki katina buyutulur (isimlerin yeri arenanin basina gore tutuldugu icin NameRef'ler bozulmaz).
+@param arena -> uzun ismin yazilacagi arena
+@param userName -> kullanici adi
+@param length -> ismin uzunlugu
+@return ismin NameRef'i
+*/
+NameRef storeName(NameArena *arena, const char *userName, int length) {
+    NameRef ref;
+
+    memset(&ref, 0, sizeof(ref));
+    ref.length = (uint32_t)length;
+    if (length <= INLINE_NAME_LENGTH) {
+        memcpy(ref.key.inlineName, userName, (size_t)length + 1);
+        return ref;
+    }
+    if (arena->used + (size_t)length + 1 > arena->capacity) {
+        size_t capacity = arena->capacity > 0 ? arena->capacity : 4096;
+        while (arena->used + (size_t)length + 1 > capacity) capacity *= 2;
+        if (capacity > UINT32_MAX) {
+            fprintf(stderr, "Isim arenasi 4 GB sinirini asti.\n");
+            exit(1);
         }
+        if (arena->mappedBytes) {
+            // kayittan acilan arenanin byte'lari dosyanin icinde, ilk eklemede bellege kopyalanir
+            char *bytes = (char *)malloc(capacity);
+            memcpy(bytes, arena->bytes, arena->used);
+            arena->bytes = bytes;
+            arena->mappedBytes = 0;
+        } else {
+            arena->bytes = (char *)realloc(arena->bytes, capacity);
+        }
+        arena->capacity = capacity;
     }
+    memcpy(ref.key.external.prefix, userName, sizeof(ref.key.external.prefix));
+    ref.key.external.offset = (uint32_t)arena->used;
+    memcpy(arena->bytes + arena->used, userName, (size_t)length + 1);
+    arena->used += (size_t)length + 1;
+    return ref;
+}
 
-    freeHashTable(table);
-    *table = newTable;
+/*
+@brief Bu fonksiyon, bir slottaki ismi C string'i olarak dondurur. Uzun isimlerde gosterici arenanin icini gosterir ve arenaya bir sonraki yazmaya kadar gecerlidir.
+@param table -> hash tablosu
+@param index -> slotun adresi
+@return kullanici adi
+*/
+const char *nameAt(HashTable *table, int index) {
+    NameRef *ref = &table->names[index];
+    if (ref->length <= INLINE_NAME_LENGTH) {
+        return ref->key.inlineName;
+    }
+    return table->arena->bytes + ref->key.external.offset;
 }
 
 /*
-@brief Programın ana fonksiyonu. Kullanıcıdan giriş alır ve hash tablosu işlemlerini yönetir.
+@brief Bu fonksiyon, bir slottaki ismi aranan isimle karsilastirir. Once uzunluklar, uzun isimlerde sonra NameRef'teki ilk 8 byte karsilastirilir; arenaya sadece bunlar tutarsa gidilir.
+@param table -> hash tablosu
+@param index -> slotun adresi
+@param userName -> aranan kullanici adi
+@param length -> aranan ismin uzunlugu
+@return isimler ayniysa 1, degilse 0
 */
-int main(int argc, char *argv[]) {
-    int n, i;
-    float loadFactor;
-    char mode[10];
-    char action = '\0', userName[MAX_NAME_LENGTH];
-    HashTable table;
+int nameEquals(HashTable *table, int index, const char *userName, int length) {
+    NameRef *ref = &table->names[index];
 
-    printf("Tabloya eklemek istediginiz eleman sayisini girin: ");
-    scanf("%d", &n);
+    if (ref->length != (uint32_t)length) return 0;
+    if (length <= INLINE_NAME_LENGTH) {
+        return memcmp(ref->key.inlineName, userName, (size_t)length) == 0;
+    }
+    return memcmp(ref->key.external.prefix, userName, sizeof(ref->key.external.prefix)) == 0 &&
+           memcmp(table->arena->bytes + ref->key.external.offset + sizeof(ref->key.external.prefix),
+                  userName + sizeof(ref->key.external.prefix), (size_t)length - sizeof(ref->key.external.prefix)) == 0;
+}
 
-    int loadFactorValid = 0;
+/*
+@brief Bu fonksiyon, yeniden kurulan bir tablonun kullanacagi arenayi secer. Arenadaki silinmis isimlerin byte'lari yarisindan azsa arena yeni tabloyla paylasilir ve isimler hic kopyalanmaz; fazlaysa bos bir arena acilir, nameForTable aktif isimleri oraya kopyalar ve eski arena eski tabloyla birlikte serbest birakilir.
+@param table -> yeniden kurulacak (eski) tablo
+@return yeni tablonun arenasi
+*/
+static NameArena *arenaForRebuild(HashTable *table) {
+    if (table->arena->deadBytes * 2 > table->arena->used) {
+        return createArena();
+    }
+    table->arena->references++;
+    return table->arena;
+}
 
-    while (!loadFactorValid) {
-        printf("Load factor degerini girin (pozitif bir sayi olmali): ");
-        if (scanf("%f", &loadFactor) == 1 && loadFactor > 0) {
-            loadFactorValid = 1; // Geçerli bir load factor girildi
-        } else {
-            printf("gecersiz load factor. Lutfen gecerli bir load factor degeri girin.\n");
-            while (getchar() != '\n'); // Geçersiz girişi temizle
-        }
+/*
+@brief Bu fonksiyon, bir slottaki ismin baska bir tabloya konacak NameRef'ini hazirlar. Iki tablo ayni arenayi kullaniyorsa NameRef oldugu gibi kullanilir, farkli arenalarda uzun isim yeni arenaya yazilir.
+@param to -> hedef tablo
+@param from -> kaynak tablo
+@param fromIndex -> kaynak slot
+@return hedef tablonun arenasina gore isim
+*/
+static NameRef nameForTable(HashTable *to, HashTable *from, int fromIndex) {
+    NameRef ref = from->names[fromIndex];
+    if (ref.length > INLINE_NAME_LENGTH && to->arena != from->arena) {
+        ref = storeName(to->arena, nameAt(from, fromIndex), (int)ref.length);
     }
+    return ref;
+}
 
-    int tableSize = calculateTableSize(n, loadFactor);
-    printf("Tablonuzun boyutu %d olarak hesaplandi.\n", tableSize);
+#if !defined(GROUP_PROBING) && !defined(ROBIN_HOOD) && !defined(CUCKOO_HASHING)
+/*
+@brief Bu fonksiyon, derlenen deneme motorunun adini dondurur.
+@return motorun adi
+*/
+const char *probeEngineName(void) {
+#if defined(LINEAR_PROBING)
+    return "linear probing";
+#elif defined(QUADRATIC_PROBING)
+    return "quadratic probing";
+#else
+    return "double hashing";
+#endif
+}
 
-    int modeValid = 0;
-    while (!modeValid) {
-        printf("Modu girin (NORMAL/DEBUG): ");
-        scanf("%s", mode);
+/*
+@brief Bu fonksiyon, verilen kullanıcı adı için hash tablosunda uygun bir yuva (slot) bulur. Her denemede once kontrol byte'i parmak izi ile karsilastirilir, strcmp sadece parmak izi tutarsa yapilir. Silinmis slotlar aramayi durdurmaz, ilki ekleme icin hatirlanir. Deneme dizisi stratejiye gore h1'den h2'lik adimlarla (double hashing), birer slot (linear) ya da 1, 2, 3, ... artan adimlarla (quadratic, h1 + i*(i+1)/2) ilerler. Quadratic dizi asal boyutlu bir tabloda slotlarin yarisini gezer; o yarida yer kalmazsa -1 dondurulur ve tablo buyutulur.
+@param table -> Arama yapılacak hash tablosu
+@param userName -> Aranacak kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param hash -> Kullanici adinin h1, h2 ve parmak izi degerleri
+@return Ismin bulundugu adres; bulunamazsa yolda gorulen ilk silinmis ya da bos slot; hic yer yoksa -1
+*/
+int findSlot(HashTable *table, char *userName, char *mode, SlotHash hash) {
+    int index = hash.h1Value;
+    int firstFree = -1;
+    int debug = DEBUG_MODE(mode);
+    int i;
 
-        // Kullanıcının girdiği modu küçük harfe çevir
-        for ( i = 0; mode[i]; i++) {
-            mode[i] = toupper(mode[i]);
+    if (debug) {
+        printf("h1(%s) = %d\n", userName, hash.h1Value);
+#if !defined(LINEAR_PROBING) && !defined(QUADRATIC_PROBING)
+        printf("h2(%s) = %d\n", userName, hash.h2Value);
+#endif
+    }
+
+    for (i = 0; i < table->size; i++) {
+        unsigned char control = table->control[index];
+
+        if (activeProbeCount != NULL) (*activeProbeCount)++;
+        if (debug) {
+            printf("Deneme %d: Adres: %d\n", i + 1, index);
         }
 
-        // Mod kontrolü
-        if (strcmp(mode, "NORMAL") == 0 || strcmp(mode, "DEBUG") == 0) {
-            modeValid = 1;
-        } else {
-            printf("gecersiz mod. Lutfen 'NORMAL' veya 'DEBUG' girin.\n");
+        if (control == SLOT_EMPTY) {
+            break;
         }
+        if (control == SLOT_DELETED) {
+            if (firstFree == -1) firstFree = index;
+        } else if (control == hash.fingerprint && nameEquals(table, index, userName, hash.length)) {
+            if (debug) {
+                printf("%s kelimesi %d. adreste bulundu.\n", userName, index);
+            }
+            return index;
+        }
+#if defined(LINEAR_PROBING)
+        index = index + 1 == table->size ? 0 : index + 1;
+#elif defined(QUADRATIC_PROBING)
+        index = (int)(((long long)index + i + 1) % table->size); // h1 + i*(i+1)/2, her adim bir oncekinden 1 uzun
+#else
+        index = (index + hash.h2Value) % table->size; // (h1 + i*h2) % size, carpim tasmadan
+#endif
     }
 
-    table = createHashTable(tableSize, loadFactor);
-
-    int shouldExit = 0;
+    if (i < table->size && firstFree == -1) firstFree = index;
+    if (debug && firstFree != -1) {
+        printf("%s kelimesi %d. adreste bulunamadı.\n", userName, firstFree);
+    }
+    return firstFree;
+}
 
-    while (!shouldExit) {
-        printf("\nEkleme (e), Silme (s), Arama (a), Goruntule (g), Duzenle (d), Cikis (q): ");
-        scanf(" %c", &action);
+/*
+@brief Bu fonksiyon, silinen bir slotun silinmis isaretlenmeden bosaltilip bosaltilamayacagini soyler. Double hashing'de her ismin adim boyu, quadratic'te her ismin o slottaki adim boyu farkli oldugu icin baska bir ismin deneme dizisinin bu slottan gecip gecmedigi bilinemez, slot her zaman silinmis olarak isaretlenir. Linear probing'de bu slottan gecen her arama sonraki slota bakar; sonraki slot bossa o arama orada zaten bitecekti, slot bosaltilabilir.
+@param table -> hash tablosu
+@param index -> silinen slotun adresi
+@return slot bosaltilabilirse 1, silinmis isaretlenmeliyse 0
+*/
+static int canClearSlot(HashTable *table, int index) {
+#if defined(LINEAR_PROBING)
+    return EMPTY_ENTRY(table, index + 1 == table->size ? 0 : index + 1);
+#else
+    (void)table;
+    (void)index;
+    return 0;
+#endif
+}
+#elif defined(GROUP_PROBING)
+/*
+@brief Bu fonksiyon, derlenen deneme motorunun adini dondurur.
+@return motorun adi
+*/
+const char *probeEngineName(void) {
+#ifdef __SSE2__
+    return "grup denemesi (SSE2)";
+#else
+    return "grup denemesi (tasinabilir)";
+#endif
+}
+
+/*
+@brief Bu fonksiyon, start adresinden baslayan 16 kontrol byte'ini tarar: parmak izi tutan slotlar ve bos slotlar icin birer bit maskesi dondurur.
+@param control -> grubun ilk kontrol byte'i
+@param fingerprint -> aranan parmak izi
+@param emptyMask -> bos slotlarin maskesi buraya yazilir
+@return parmak izi tutan slotlarin maskesi
+*/
+static unsigned int matchGroup(const unsigned char *control, unsigned char fingerprint, unsigned int *emptyMask) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i *)control);
+    *emptyMask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)SLOT_EMPTY)));
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)fingerprint)));
+#else
+    unsigned int matchMask = 0, empty = 0;
+    int k;
+    for (k = 0; k < GROUP_SIZE; k++) {
+        matchMask |= (unsigned int)(control[k] == fingerprint) << k;
+        empty |= (unsigned int)(control[k] == SLOT_EMPTY) << k;
+    }
+    *emptyMask = empty;
+    return matchMask;
+#endif
+}
+
+/*
+@brief Bu fonksiyon, findSlot'un grup denemesi surumudur. Gruplar h1'den baslar ve 16'sar slot ilerler; her grupta parmak izi tutan slotlar strcmp ile kontrol edilir, grupta bos slot varsa isim tabloda yoktur.
+@param table -> Arama yapılacak hash tablosu
+@param userName -> Aranacak kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param hash -> Kullanici adinin h1, h2 ve parmak izi degerleri
+@return Ismin bulundugu adres; bulunamazsa yolda gorulen ilk silinmis ya da bos slot; hic yer yoksa -1
+*/
+int findSlot(HashTable *table, char *userName, char *mode, SlotHash hash) {
+    int start = hash.h1Value;
+    int firstFree = -1;
+    int groupCount = (table->size + GROUP_SIZE - 1) / GROUP_SIZE;
+    int debug = DEBUG_MODE(mode);
+    int g;
+
+    if (debug) {
+        printf("h1(%s) = %d\n", userName, hash.h1Value);
+        printf("parmak izi(%s) = %d\n", userName, hash.fingerprint);
+    }
+
+    for (g = 0; g < groupCount; g++) {
+        unsigned int emptyMask;
+        unsigned int matchMask = matchGroup(table->control + start, hash.fingerprint, &emptyMask);
+
+        if (activeProbeCount != NULL) (*activeProbeCount)++;
+        if (debug) {
+            printf("Grup %d: Adres: %d - %d\n", g + 1, start, (start + GROUP_SIZE - 1) % table->size);
+        }
+
+        while (matchMask != 0) {
+            int bit = __builtin_ctz(matchMask);
+            int index = (start + bit) % table->size;
+            if (nameEquals(table, index, userName, hash.length)) {
+                if (debug) {
+                    printf("%s kelimesi %d. adreste bulundu.\n", userName, index);
+                }
+                return index;
+            }
+            matchMask &= matchMask - 1;
+        }
+
+        if (firstFree == -1) {
+            // bu gruptaki ilk silinmis ya da bos slot ekleme icin hatirlanir
+            int k;
+            for (k = 0; k < GROUP_SIZE; k++) {
+                if (!((table->control[start + k] & 0x80) == 0)) {
+                    firstFree = (start + k) % table->size;
+                    break;
+                }
+            }
+        }
+        if (emptyMask != 0) {
+            break;
+        }
+        start = (start + GROUP_SIZE) % table->size;
+    }
+
+    if (debug && firstFree != -1) {
+        printf("%s kelimesi %d. adreste bulunamadı.\n", userName, firstFree);
+    }
+    return firstFree;
+}
+
+/*
+@brief Bu fonksiyon, silinen bir slotun silinmis isaretlenmeden bosaltilip bosaltilamayacagini soyler. Bir arama bir gruptan sonrakine ancak gruptaki 16 slotun hicbiri bos degilse gecer. Slotun iki yanindaki bos olmayan slotlarla birlikte 16 slotluk kesintisiz bir dolu bolge yoksa hicbir arama bu slotun uzerinden baska bir gruba gecmemistir, slot bosaltilabilir. Tablo 16 slottan kucukse tek grup tum tabloyu kapsar, her zaman bosaltilabilir.
+@param table -> hash tablosu
+@param index -> silinen slotun adresi
+@return slot bosaltilabilirse 1, silinmis isaretlenmeliyse 0
+*/
+static int canClearSlot(HashTable *table, int index) {
+    int before = 0, after = 0;
+
+    if (table->size <= GROUP_SIZE) return 1;
+    while (before < GROUP_SIZE && !EMPTY_ENTRY(table, (index - before - 1 + table->size) % table->size)) before++;
+    while (after < GROUP_SIZE && !EMPTY_ENTRY(table, (index + after + 1) % table->size)) after++;
+    return before + after + 1 < GROUP_SIZE;
+}
+#endif
+
+#ifdef ROBIN_HOOD
+/*
+@brief Bu fonksiyon, derlenen deneme motorunun adini dondurur.
+@return motorun adi
+*/
+const char *probeEngineName(void) {
+    return "robin hood";
+}
+
+/*
+@brief Bu fonksiyon, index'teki slotun home slotundan kac adim ileride oldugunu hesaplar (tablonun sonundan basa donerek).
+@param table -> hash tablosu
+@param home -> elemanin h1 degeri
+@param index -> slotun adresi
+@return uzaklik
+*/
+static int probeDistance(HashTable *table, int home, int index) {
+    int distance = index - home;
+    return distance < 0 ? distance + table->size : distance;
+}
+
+/*
+@brief Bu fonksiyon, dolu bir slottaki elemanin h1'ine uzakligini dondurur. Uzaklik kontrol byte'inda tutulur; RH_SATURATED ve ustu icin h1 ismin hash'inden yeniden hesaplanir.
+@param table -> hash tablosu
+@param index -> dolu bir slotun adresi
+@return elemanin h1'ine uzakligi
+*/
+static int slotDistance(HashTable *table, int index) {
+    unsigned char control = table->control[index];
+    if (control < RH_SATURATED) return control;
+    return probeDistance(table, tableSlotHash(table, (char *)nameAt(table, index)).h1Value, index);
+}
+
+/*
+@brief Bu fonksiyon, findSlot'un Robin Hood surumudur. Elemanlar linear probing gibi h1'den baslayarak art arda slotlara konur ama her slotun kontrol byte'inda parmak izi yerine elemanin h1'ine uzakligi durur. Bir kumede elemanlar h1'lerine gore sirali oldugundan arama, uzakligi aranan ismin o anki uzakligindan kucuk bir elemana geldiginde durur: isim tabloda olsaydi bu slottan once bulunurdu. strcmp sadece uzakligi aranan ismin uzakligina esit, yani ayni h1'e sahip elemanlarda yapilir. Silinmis slotlar sadece tasinmakta olan eski tabloda bulunur ve aramayi durdurmaz.
+@param table -> Arama yapılacak hash tablosu
+@param userName -> Aranacak kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param hash -> Kullanici adinin h1 degeri
+@return Ismin bulundugu adres; bulunamazsa ismin konacagi slot (bos ya da ismin yerine gececegi daha yakin bir eleman); tablo doluysa -1
+*/
+int findSlot(HashTable *table, char *userName, char *mode, SlotHash hash) {
+    int index = hash.h1Value;
+    int debug = DEBUG_MODE(mode);
+    int i;
+
+    if (debug) {
+        printf("h1(%s) = %d\n", userName, hash.h1Value);
+    }
+
+    for (i = 0; i < table->size; i++) {
+        unsigned char control = table->control[index];
+
+        if (activeProbeCount != NULL) (*activeProbeCount)++;
+        if (debug) {
+            printf("Deneme %d: Adres: %d\n", i + 1, index);
+        }
+
+        if (control == SLOT_EMPTY) {
+            break;
+        }
+        if (control != SLOT_DELETED) {
+            int distance = control < RH_SATURATED ? control : slotDistance(table, index);
+            if (distance < i) {
+                break;
+            }
+            if (distance == i && nameEquals(table, index, userName, hash.length)) {
+                if (debug) {
+                    printf("%s kelimesi %d. adreste bulundu.\n", userName, index);
+                }
+                return index;
+            }
+        }
+        index = index + 1 == table->size ? 0 : index + 1;
+    }
+
+    if (i == table->size) return -1;
+    if (debug) {
+        printf("%s kelimesi %d. adreste bulunamadı.\n", userName, index);
+    }
+    return index;
+}
+
+/*
+@brief Bu fonksiyon, findSlot'un dondurdugu slotta aranan ismin olup olmadigini soyler. findSlot dolu bir slotu ya ismi bulunca (eleman ayni uzaklikta) ya da daha yakin bir elemanda durunca dondurur, uzakliklari karsilastirmak yeter.
+@param table -> hash tablosu
+@param index -> findSlot'un dondurdugu adres
+@param userName -> aranan isim
+@param hash -> ismin hash degerleri
+@return isim bu slottaysa 1, degilse 0
+*/
+static int slotHasName(HashTable *table, int index, char *userName, SlotHash hash) {
+    (void)userName;
+    return (table->control[index] & 0x80) == 0 && slotDistance(table, index) == probeDistance(table, hash.h1Value, index);
+}
+
+/*
+@brief Bu fonksiyon, bir ismi findSlot'un buldugu slota koyar. Slot doluysa o slottan kumenin sonundaki ilk bos slota kadar olan elemanlar birer slot ileri kaydirilir (her birinin uzakligi 1 artar), boylece kumedeki h1 sirasi bozulmaz.
+@param table -> hash tablosu
+@param index -> findSlot'un dondurdugu slot
+@param ref -> tablonun arenasina gore isim
+@param hash -> ismin hash degerleri
+@return ismin konuldugu adres, tabloda bos slot yoksa -1
+*/
+static int placeName(HashTable *table, int index, NameRef ref, SlotHash hash) {
+    int distance = probeDistance(table, hash.h1Value, index);
+    int end = index, j;
+
+    while ((table->control[end] & 0x80) == 0) {
+        end = end + 1 == table->size ? 0 : end + 1;
+        if (end == index) return -1;
+    }
+    if (DELETED_ENTRY(table, end)) {
+        table->deletedCount--;
+    } else {
+        table->elementCount++;
+    }
+    for (j = end; j != index;) {
+        int previous = j == 0 ? table->size - 1 : j - 1;
+        int moved = slotDistance(table, previous) + 1;
+        table->names[j] = table->names[previous];
+        setControl(table, j, (unsigned char)(moved < RH_SATURATED ? moved : RH_SATURATED));
+        j = previous;
+    }
+    table->names[index] = ref;
+    setControl(table, index, (unsigned char)(distance < RH_SATURATED ? distance : RH_SATURATED));
+    return index;
+}
+
+/*
+@brief Bu fonksiyon, bir slotu silinmis isaretlemeden bosaltir (backward shift): sonraki elemanlar h1'lerinde olmadiklari surece birer slot geri kaydirilir. Boylece Robin Hood tablosunda hic silinmis slot birikmez.
+@param table -> hash tablosu
+@param index -> silinen elemanin adresi
+*/
+static void removeSlot(HashTable *table, int index) {
+    int next = index + 1 == table->size ? 0 : index + 1;
+    int step;
+
+    for (step = 1; step < table->size && (table->control[next] & 0x80) == 0; step++) {
+        int distance = slotDistance(table, next);
+        if (distance == 0) break;
+        table->names[index] = table->names[next];
+        setControl(table, index, (unsigned char)(distance - 1 < RH_SATURATED ? distance - 1 : RH_SATURATED));
+        index = next;
+        next = next + 1 == table->size ? 0 : next + 1;
+    }
+    setControl(table, index, SLOT_EMPTY);
+    table->elementCount--;
+}
+#endif
+
+#ifdef CUCKOO_HASHING
+/*
+@brief Bu fonksiyon, derlenen deneme motorunun adini dondurur.
+@return motorun adi
+*/
+const char *probeEngineName(void) {
+    return "cuckoo (2 x 4 slot)";
+}
+
+/*
+@brief Bu fonksiyon, bir ismin cuckoo tablosunda durabilecegi k'inci slotu dondurur. Her ismin CUCKOO_WINDOW slotluk iki penceresi vardir: biri h1'den, digeri h1 + h2'den baslar.
+@param table -> hash tablosu
+@param hash -> ismin hash degerleri
+@param k -> 0 .. 2 * CUCKOO_WINDOW - 1
+@return slotun adresi
+*/
+static int cuckooSlot(HashTable *table, SlotHash hash, int k) {
+    long long start = k < CUCKOO_WINDOW ? hash.h1Value : (long long)hash.h1Value + hash.h2Value;
+    return (int)((start + k % CUCKOO_WINDOW) % table->size);
+}
+
+/*
+@brief Bu fonksiyon, findSlot'un cuckoo surumudur. Isim sadece iki penceresindeki 2 * CUCKOO_WINDOW slottan birinde olabilir, arama en fazla iki pencereye bakar (deneme sayisi pencere sayisidir) ve hicbir zaman kume boyunca ilerlemez.
+@param table -> Arama yapılacak hash tablosu
+@param userName -> Aranacak kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param hash -> Kullanici adinin h1, h2 ve parmak izi degerleri
+@return Ismin bulundugu adres; bulunamazsa pencerelerdeki ilk bos slot; iki pencere de doluysa ilk pencerenin ilk slotu (placeName oradaki elemani yerinden eder)
+*/
+int findSlot(HashTable *table, char *userName, char *mode, SlotHash hash) {
+    int firstFree = -1;
+    int debug = DEBUG_MODE(mode);
+    int k;
+
+    if (debug) {
+        printf("h1(%s) = %d\n", userName, hash.h1Value);
+        printf("h2(%s) = %d\n", userName, hash.h2Value);
+    }
+
+    for (k = 0; k < 2 * CUCKOO_WINDOW; k++) {
+        int index = cuckooSlot(table, hash, k);
+        unsigned char control = table->control[index];
+
+        if (k % CUCKOO_WINDOW == 0) {
+            if (activeProbeCount != NULL) (*activeProbeCount)++;
+            if (debug) {
+                printf("Pencere %d: Adres: %d\n", k / CUCKOO_WINDOW + 1, index);
+            }
+        }
+        if (control == hash.fingerprint && nameEquals(table, index, userName, hash.length)) {
+            if (debug) {
+                printf("%s kelimesi %d. adreste bulundu.\n", userName, index);
+            }
+            return index;
+        }
+        if (firstFree == -1 && (control & 0x80) != 0) firstFree = index;
+    }
+
+    if (firstFree == -1) firstFree = hash.h1Value;
+    if (debug) {
+        printf("%s kelimesi %d. adreste bulunamadı.\n", userName, firstFree);
+    }
+    return firstFree;
+}
+
+/*
+@brief Bu fonksiyon, findSlot'un dondurdugu slotta aranan ismin olup olmadigini soyler. Iki pencere de doluysa findSlot ismin olmadigi dolu bir slot dondurur, bu yuzden isim karsilastirilir.
+@param table -> hash tablosu
+@param index -> findSlot'un dondurdugu adres
+@param userName -> aranan isim
+@param hash -> ismin hash degerleri
+@return isim bu slottaysa 1, degilse 0
+*/
+static int slotHasName(HashTable *table, int index, char *userName, SlotHash hash) {
+    return table->control[index] == hash.fingerprint && nameEquals(table, index, userName, hash.length);
+}
+
+/*
+@brief Bu fonksiyon, bir ismi findSlot'un buldugu slota koyar. Slot doluysa (iki pencere de dolu) once bir yer degistirme zinciri aranir: bir elemanin yeri alinir, o eleman kendi diger penceresine gider, orasi da doluysa oradaki eleman yerinden edilir... En fazla CUCKOO_MAX_KICKS adimda bos bir slot bulunursa zincir sondan basa uygulanir; bulunamazsa tablo hic degismeden -1 dondurulur.
+@param table -> hash tablosu
+@param index -> findSlot'un dondurdugu slot
+@param ref -> tablonun arenasina gore isim
+@param hash -> ismin hash degerleri
+@return ismin konuldugu adres, zincir bulunamazsa -1
+*/
+static int placeName(HashTable *table, int index, NameRef ref, SlotHash hash) {
+    unsigned int victimCounter = hash.fingerprint; // yerinden edilecek slot sirayla secilir, zincir ayni yerde donmez
+    int path[CUCKOO_MAX_KICKS];
+    int length = 0, freeSlot = (table->control[index] & 0x80) != 0 ? index : -1;
+    SlotHash current = hash;
+
+    while (freeSlot == -1) {
+        int victim = -1, k, j;
+
+        if (length == CUCKOO_MAX_KICKS) return -1;
+        for (k = 0; k < 2 * CUCKOO_WINDOW && freeSlot == -1; k++) {
+            int slot = cuckooSlot(table, current, k);
+            if ((table->control[slot] & 0x80) != 0) freeSlot = slot;
+        }
+        if (freeSlot != -1) break;
+        for (k = 0; k < 2 * CUCKOO_WINDOW && victim == -1; k++) {
+            int slot = cuckooSlot(table, current, (int)((victimCounter + k) % (2 * CUCKOO_WINDOW)));
+            victim = slot;
+            for (j = 0; j < length; j++) {
+                if (path[j] == slot) victim = -1;
+            }
+        }
+        victimCounter++;
+        if (victim == -1) return -1;
+        path[length++] = victim;
+        current = tableSlotHash(table, (char *)nameAt(table, victim));
+    }
+
+    if (DELETED_ENTRY(table, freeSlot)) {
+        table->deletedCount--;
+    } else {
+        table->elementCount++;
+    }
+    while (length > 0) {
+        int from = path[--length];
+        table->names[freeSlot] = table->names[from];
+        setControl(table, freeSlot, table->control[from]);
+        freeSlot = from;
+    }
+    table->names[freeSlot] = ref;
+    setControl(table, freeSlot, hash.fingerprint);
+    return freeSlot;
+}
+
+/*
+@brief Bu fonksiyon, bir slotu bosaltir. Cuckoo'da aramalar pencereler disina cikmadigi icin silinmis isaretine gerek yoktur.
+@param table -> hash tablosu
+@param index -> silinen elemanin adresi
+*/
+static void removeSlot(HashTable *table, int index) {
+    setControl(table, index, SLOT_EMPTY);
+    table->elementCount--;
+}
+#endif
+
+#if !defined(ROBIN_HOOD) && !defined(CUCKOO_HASHING)
+/*
+@brief Bu fonksiyon, findSlot'un dondurdugu slotta aranan ismin olup olmadigini soyler. Bu stratejilerde findSlot dolu bir slotu sadece ismi bulunca dondurur.
+@param table -> hash tablosu
+@param index -> findSlot'un dondurdugu adres
+@param userName -> aranan isim
+@param hash -> ismin hash degerleri
+@return isim bu slottaysa 1, degilse 0
+*/
+static int slotHasName(HashTable *table, int index, char *userName, SlotHash hash) {
+    (void)userName;
+    (void)hash;
+    return !EMPTY_ENTRY(table, index) && !DELETED_ENTRY(table, index);
+}
+
+/*
+@brief Bu fonksiyon, bir ismi findSlot'un buldugu bos ya da silinmis slota koyar.
+@param table -> hash tablosu
+@param index -> findSlot'un dondurdugu slot
+@param ref -> tablonun arenasina gore isim
+@param hash -> ismin hash degerleri
+@return ismin konuldugu adres
+*/
+static int placeName(HashTable *table, int index, NameRef ref, SlotHash hash) {
+    if (DELETED_ENTRY(table, index)) {
+        table->deletedCount--;
+    } else {
+        table->elementCount++;
+    }
+    table->names[index] = ref;
+    setControl(table, index, hash.fingerprint);
+    return index;
+}
+
+/*
+@brief Bu fonksiyon, bir slotu siler: canClearSlot izin veriyorsa bos, vermiyorsa silinmis olarak isaretler.
+@param table -> hash tablosu
+@param index -> silinen elemanin adresi
+*/
+static void removeSlot(HashTable *table, int index) {
+    if (canClearSlot(table, index)) {
+        setControl(table, index, SLOT_EMPTY);
+        table->elementCount--;
+    } else {
+        setControl(table, index, SLOT_DELETED);
+        table->deletedCount++;
+    }
+}
+#endif
+
+/*
+@brief Bu fonksiyon, bir isim yerlestirilemediginde (cuckoo'da yer degistirme zinciri bulunamadiginda, quadratic dizide ya da tabloda bos slot kalmadiginda) tabloyu hemen iki katindan buyuk bir asal boyutta yeniden kurar. Arena ve tasinmakta olan eski tablo (previous) oldugu gibi kalir, buyume kaldigi yerden devam eder. Yeni boyutta da yerlestirme basarisiz olursa boyut yine iki katina cikar.
+@param table -> hash tablosu
+*/
+static void enlargeTable(HashTable *table) {
+    int newSize = table->size;
+
+    for (;;) {
+        HashTable larger;
+        int i, placed = 1;
+
+        newSize = calculateTableSize(2 * newSize, 1.0f);
+        larger = createHashTable(newSize, table->loadFactor);
+        larger.hashShift = table->hashShift;
+        releaseArena(larger.arena);
+        larger.arena = table->arena;
+        for (i = 0; i < table->size && placed; i++) {
+            if (!EMPTY_ENTRY(table, i) && !DELETED_ENTRY(table, i)) {
+                char *userName = (char *)nameAt(table, i);
+                SlotHash hash = tableSlotHash(&larger, userName);
+                int index = findSlot(&larger, userName, "NORMAL", hash);
+                placed = index != -1 && placeName(&larger, index, table->names[i], hash) != -1;
+            }
+        }
+        if (placed) {
+            if (!table->mapped) {
+                free(table->control);
+                free(table->names);
+            }
+            table->control = larger.control;
+            table->names = larger.names;
+            table->size = newSize;
+            table->elementCount = larger.elementCount;
+            table->deletedCount = larger.deletedCount;
+            table->mapped = 0;
+            return;
+        }
+        free(larger.control);
+        free(larger.names);
+    }
+}
+
+/*
+@brief Bu fonksiyon, tabloda olmadigi bilinen bir ismi yerlestirir; yer bulunamazsa tabloyu enlargeTable ile buyutup tekrar dener, bu yuzden hicbir zaman basarisiz olmaz. Tasima ve rehash bunu kullanir.
+@param table -> hash tablosu
+@param userName -> isim
+@param ref -> tablonun arenasina gore isim
+@param hash -> ismin tablonun su anki boyutuna gore hash degerleri
+@return ismin konuldugu adres
+*/
+static int placeOrEnlarge(HashTable *table, char *userName, NameRef ref, SlotHash hash) {
+    for (;;) {
+        int index = findSlot(table, userName, "NORMAL", hash);
+        if (index != -1 && (index = placeName(table, index, ref, hash)) != -1) {
+            return index;
+        }
+        enlargeTable(table);
+        hash = tableSlotHash(table, userName);
+    }
+}
+
+/*
+@brief Bu fonksiyon, hash tablosuna yeni bir kullanici adi ekler ama ekrana bir sey yazmaz. Tablo buyurken isim eski tabloda da aranir; ekleme her zaman yeni tabloya yapilir.
+@param table -> Ekleme yapılacak hash tablosu
+@param userName -> Eklenecek kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param n -> Maksimum eleman sayısı, sadece tablo buyumuyorsa (autoResize 0) kullanilir
+@return Elemanin yerlestirildigi adres ya da RESULT_LIMIT, RESULT_TABLE_FULL, RESULT_EXISTS, RESULT_READ_ONLY
+*/
+int insertName(HashTable *table, char *userName, char *mode, int n) {
+    return insertNameHashed(table, userName, mode, n, tableSlotHash(table, userName));
+}
+
+/*
+@brief Bu fonksiyon, insertName'in hash degerleri onceden hesaplanmis surumudur; toplu islemler hash'leri once hesaplayip slotlari onceden bellege cagirir.
+@param table -> Ekleme yapılacak hash tablosu
+@param userName -> Eklenecek kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param n -> Maksimum eleman sayısı, sadece tablo buyumuyorsa (autoResize 0) kullanilir
+@param hash -> ismin tablonun su anki boyutuna gore hesaplanmis degerleri
+@return Elemanin yerlestirildigi adres ya da RESULT_LIMIT, RESULT_TABLE_FULL, RESULT_EXISTS, RESULT_READ_ONLY
+*/
+int insertNameHashed(HashTable *table, char *userName, char *mode, int n, SlotHash hash) {
+    int hashedSize = table->size;
+
+    if (table->readOnly) {
+        return RESULT_READ_ONLY;
+    }
+    migrateStep(table);
+
+    if (!table->autoResize && table->elementCount - table->deletedCount >= n) {
+        return RESULT_LIMIT;
+    }
+    if (takeFromPrevious(table, userName) != RESULT_NOT_FOUND) {
+        return RESULT_EXISTS;
+    }
+    if (table->size != hashedSize) {
+        // tasima sirasinda tablo buyutulmus olabilir, h1 ve h2 yeni boyuta gore tekrar hesaplanir
+        hash = tableSlotHash(table, userName);
+    }
+
+    int index = findSlot(table, userName, mode, hash);
+
+    if (index != -1 && slotHasName(table, index, userName, hash)) {
+        return RESULT_EXISTS;
+    }
+    if (index == -1 && !table->autoResize) {
+        return RESULT_TABLE_FULL;
+    }
+
+    NameRef ref = storeName(table->arena, userName, hash.length);
+    if (index != -1) {
+        index = placeName(table, index, ref, hash);
+    }
+    if (index == -1) {
+        // cuckoo zinciri bulunamadi ya da deneme dizisinde yer yok
+        if (!table->autoResize) {
+            if (ref.length > INLINE_NAME_LENGTH) table->arena->deadBytes += ref.length + 1;
+            return RESULT_TABLE_FULL;
+        }
+        enlargeTable(table);
+        index = placeOrEnlarge(table, userName, ref, tableSlotHash(table, userName));
+    }
+    if (table->filter != NULL) {
+        filterAdd(table->filter, hash.value);
+        if (table->filter->count > table->filter->capacity) buildFilter(table);
+    }
+    if (table->autoResize && table->previous == NULL && table->elementCount > growThreshold(table)) {
+        startResize(table, mode, 1);
+        // eleman henuz tasinmamis olabilir, hemen tasinir ve yeni tablodaki adresi dondurulur
+        index = takeFromPrevious(table, userName);
+        if (index == RESULT_NOT_FOUND) {
+            index = findSlot(table, userName, "NORMAL", tableSlotHash(table, userName));
+        }
+    }
+    return index;
+}
+
+/*
+@brief Bu fonksiyon, hash tablosuna yeni bir giriş ekler.
+@param table -> Ekleme yapılacak hash tablosu
+@param userName -> Eklenecek kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param n -> Maksimum eleman sayısı
+*/
+void insertEntry(HashTable *table, char *userName, char *mode, int n) {
+    int oldSize = table->size;
+    int index = insertName(table, userName, mode, n);
+
+    if (table->size != oldSize) {
+        printf("Tablo doldugu icin %d boyutundan %d boyutuna buyutuluyor.\n", oldSize, table->size);
+    }
+    if (index == RESULT_LIMIT) {
+        printf("Tabloya %d kadar eleman girdiniz. Tekrar ekleme yapamazsiniz.\n", n);
+    } else if (index == RESULT_TABLE_FULL) {
+        printf("Tablo dolu, daha fazla eleman ekleyemezsiniz.\n");
+    } else if (index == RESULT_EXISTS) {
+        printf("Eleman tabloda mevcut oldugu icin ekleme islemi yapilmadi\n");
+    } else if (index == RESULT_READ_ONLY) {
+        printf("Tablo salt okunur acildi, ekleme yapilamaz.\n");
+    } else {
+        printf("Elemaniniz %d. adrese yerlestirildi.\n", index);
+    }
+}
+
+/*
+@brief Bu fonksiyon, hash tablosundan bir kullanici adini siler ama ekrana bir sey yazmaz.
+@param table -> Silme işlemi yapılacak hash tablosu
+@param userName -> Silinecek kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@return Silinen elemanin adresi ya da RESULT_NOT_FOUND
+*/
+int deleteName(HashTable *table, char *userName, char *mode) {
+    return deleteNameHashed(table, userName, mode, tableSlotHash(table, userName));
+}
+
+/*
+@brief Bu fonksiyon, deleteName'in hash degerleri onceden hesaplanmis surumudur. Aramadaki gibi filtrede olmayan isim icin tabloya bakilmaz; silinen isim filtreden de cikarilir.
+@param table -> Silme yapılacak hash tablosu
+@param userName -> Silinecek kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param hash -> ismin tablonun su anki boyutuna gore hesaplanmis degerleri
+@return Silinen elemanin adresi ya da RESULT_NOT_FOUND, RESULT_READ_ONLY
+*/
+int deleteNameHashed(HashTable *table, char *userName, char *mode, SlotHash hash) {
+    int hashedSize = table->size;
+
+    if (table->readOnly) {
+        return RESULT_READ_ONLY;
+    }
+    migrateStep(table);
+    if (table->filter != NULL && !filterMayContain(table->filter, hash.value)) {
+        return RESULT_NOT_FOUND;
+    }
+    takeFromPrevious(table, userName);
+    if (table->size != hashedSize) {
+        hash = tableSlotHash(table, userName);
+    }
+
+    int index = findSlot(table, userName, mode, hash);
+
+    if (index != -1 && slotHasName(table, index, userName, hash)) {
+        if (table->names[index].length > INLINE_NAME_LENGTH) {
+            table->arena->deadBytes += table->names[index].length + 1;
+        }
+        removeSlot(table, index);
+        if (table->filter != NULL) filterRemove(table->filter, hash.value);
+        if (table->autoCompact && table->previous == NULL && table->deletedCount > table->size * COMPACT_RATIO) {
+            startResize(table, mode, 0); // cok fazla silinmis slot birikti, yeni tabloya sadece aktifler tasinir
+        }
+        return index;
+    }
+    return RESULT_NOT_FOUND;
+}
+
+/*
+@brief Bu fonksiyon, hash tablosundan bir girişi siler.
+@param table -> Silme işlemi yapılacak hash tablosu
+@param userName -> Silinecek kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+*/
+void deleteEntry(HashTable *table, char *userName, char *mode) {
+    int index = deleteName(table, userName, mode);
+
+    if (index == RESULT_READ_ONLY) {
+        printf("Tablo salt okunur acildi, silme yapilamaz.\n");
+    } else if (index != RESULT_NOT_FOUND) {
+        printf("%d adresindeki %s elemani silindi.\n", index, userName);
+    } else {
+        printf("%s elemani tabloda bulunmuyor.\n", userName);
+    }
+}
+
+/*
+@brief Bu fonksiyon, hash tablosunda belirtilen kullanıcı adını arar ama ekrana bir sey yazmaz.
+@param table -> Arama yapılacak hash tablosu
+@param userName -> Aranacak kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@return Elemanin adresi ya da RESULT_NOT_FOUND
+*/
+int searchName(HashTable *table, char *userName, char *mode) {
+    return searchNameHashed(table, userName, mode, tableSlotHash(table, userName));
+}
+
+/*
+@brief Bu fonksiyon, searchName'in hash degerleri onceden hesaplanmis surumudur. Tabloda filtre varsa ve isim filtrede yoksa tabloya (ve buyume sirasinda eski tabloya) hic bakilmadan RESULT_NOT_FOUND dondurulur.
+@param table -> Arama yapılacak hash tablosu
+@param userName -> Aranacak kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param hash -> ismin tablonun su anki boyutuna gore hesaplanmis degerleri
+@return Elemanin adresi ya da RESULT_NOT_FOUND
+*/
+int searchNameHashed(HashTable *table, char *userName, char *mode, SlotHash hash) {
+    int hashedSize = table->size;
+
+    migrateStep(table);
+    if (table->filter != NULL && !filterMayContain(table->filter, hash.value)) {
+        if (DEBUG_MODE(mode)) {
+            printf("Filtre: %s filtrede yok, tabloya bakilmadi\n", userName);
+        }
+        return RESULT_NOT_FOUND;
+    }
+
+    int index = takeFromPrevious(table, userName);
+    if (index != RESULT_NOT_FOUND) {
+        return index;
+    }
+    if (table->size != hashedSize) {
+        hash = tableSlotHash(table, userName);
+    }
+    index = findSlot(table, userName, mode, hash);
+
+    if (index != -1 && slotHasName(table, index, userName, hash)) {
+        return index;
+    }
+    return RESULT_NOT_FOUND;
+}
+
+/*
+@brief Bu fonksiyon, hash tablosunda belirtilen kullanıcı adını arar.
+@param table -> Arama yapılacak hash tablosu
+@param userName -> Aranacak kullanıcı adı
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@return Tablodaki kullanici adinin adresi veya NULL
+*/
+const char *searchEntry(HashTable *table, char *userName, char *mode) {
+    int index = searchName(table, userName, mode);
+    if (index != RESULT_NOT_FOUND) {
+        printf("%s elemani %d adresinde bulunuyor.\n", userName, index);
+        return nameAt(table, index);
+    } else {
+        printf("%s elemani tabloda bulunamadi.\n", userName);
+        return NULL;
+    }
+}
+
+/*
+@brief Bu fonksiyon, hash tablosunu yeniden düzenler (rehash).
+@param table -> Yeniden düzenlenecek hash tablosu
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+*/
+void rehash(HashTable *table, char *mode) {
+    int i;
+    int oldSize = table->size;
+
+    finishMigration(table);
+
+    // Aynı boyutta yeni bir tablo oluştur, isimler ayni arenada kalir
+    HashTable tempTable = createHashTable(oldSize, table->loadFactor);
+    releaseArena(tempTable.arena);
+    tempTable.arena = arenaForRebuild(table);
+    tempTable.hashShift = table->hashShift;
+
+    for (i = 0; i < oldSize; i++) {
+        if (!EMPTY_ENTRY(table, i) && !DELETED_ENTRY(table, i)) {
+            const char *userName = nameAt(table, i);
+            SlotHash hash = tableSlotHash(&tempTable, (char *)userName);
+
+            // Eski tablodaki eleman için yeni adresi bul
+            int newIndex = placeOrEnlarge(&tempTable, (char *)userName, nameForTable(&tempTable, table, i), hash);
+
+            if (DEBUG_MODE(mode)) {
+                printf("Rehash: Eski Adres: %d, Yeni Adres: %d, Kullanici: %s\n", i, newIndex, userName);
+            }
+
+        }
+    }
+
+    // Eski tabloyu serbest bırak ve yeni tabloyu atama
+    inheritSettings(&tempTable, table);
+    tempTable.compactionCount++;
+    table->filter = NULL;
+    freeHashTable(table);
+    *table = tempTable;
+}
+
+/*
+@brief Bu fonksiyon, menudeki 'd' komutudur: silinmis slotlari temizlemek icin tabloyu ayni boyutta hemen yeniden kurar (rehash), sadece aktif elemanlar tasinir. Eskiden yeni tabloya sadece silinmis elemanlar tasiniyordu, aktif elemanlar kayboluyordu.
+@param table -> düzenlenecek hash tablosu
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+*/
+void reorganizeTable(HashTable *table, char *mode) {
+    if (table->readOnly) {
+        printf("Tablo salt okunur acildi, duzenleme yapilamaz.\n");
+        return;
+    }
+    finishMigration(table);
+
+    if (table->elementCount == 0) {
+        printf("Tablo bos, eleman ekleyip silmeden duzenleme yapilamaz.\n");
+        return;
+    }
+
+    if (!hasDeletedEntry(table)) {
+        printf("Tabloda silinmis eleman yok. once eleman silin ve sonra duzenleyin.\n");
+        return;
+    }
+
+    rehash(table, mode);
+}
+
+/*
+@brief Bu fonksiyon, yeniden kurulan bir tabloya eski tablonun ayarlarini ve temizlik sayacini aktarir.
+@param to -> yeni tablo
+@param from -> eski tablo
+*/
+void inheritSettings(HashTable *to, HashTable *from) {
+    to->autoResize = from->autoResize;
+    to->migrateStep = from->migrateStep;
+    to->autoCompact = from->autoCompact;
+    to->compactionCount = from->compactionCount;
+    to->readOnly = from->readOnly;
+    to->hashShift = from->hashShift;
+    to->filter = from->filter;
+}
+
+/*
+@brief Bu fonksiyon, tablonun buyumeye basladigi dolu slot sayisini hesaplar.
+@param table -> hash tablosu
+@return bu sayidan fazla bos olmayan slot varsa tablo buyur
+*/
+int growThreshold(HashTable *table) {
+    float load = table->loadFactor < MAX_GROW_LOAD ? table->loadFactor : MAX_GROW_LOAD;
+    return (int)(table->size * load);
+}
+
+/*
+@brief Bu fonksiyon, tablonun kademeli olarak yeniden kurulmasini baslatir: mevcut tablo eski tablo olur ve bos bir tablo acilir, eski tablodaki aktif elemanlar sonraki islemlerle yavas yavas tasinir. Buyumede yeni tablo aktif eleman sayisinin en az iki katina yeter; temizlikte ayni boyutta kalir, silinmis slotlar tasinmadigi icin yok olur.
+@param table -> yeniden kurulacak hash tablosu
+@param mode -> Çalışma modu (DEBUG veya NORMAL)
+@param grow -> 1 ise buyume, 0 ise silinmis slot temizligi
+*/
+void startResize(HashTable *table, char *mode, int grow) {
+    HashTable *previous = (HashTable *)malloc(sizeof(HashTable));
+    int liveCount = table->elementCount - table->deletedCount;
+    float load = table->loadFactor < MAX_GROW_LOAD ? table->loadFactor : MAX_GROW_LOAD;
+    // eski tablo size / migrateStep islemde bosalir; bu sure icinde yapilabilecek eklemelere de yer ayrilir ki
+    // yeni tablo tasinma bitmeden dolmasin
+    int migrationOps = table->size / table->migrateStep + 1;
+    int capacity = liveCount + migrationOps + 1;
+    int newSize;
+    HashTable grown;
+
+    if (grow && capacity < 2 * liveCount) capacity = 2 * liveCount;
+    newSize = calculateTableSize(capacity, load);
+    if (!grow && newSize < table->size) newSize = table->size;
+
+    if (newSize < MIN_TABLE_SIZE) newSize = MIN_TABLE_SIZE;
+    *previous = *table;
+    previous->previous = NULL;
+    previous->filter = NULL; // filtre tablodaki isim kumesine aittir, yeni tabloya gecer
+
+    grown = createHashTable(newSize, table->loadFactor);
+    releaseArena(grown.arena);
+    grown.arena = arenaForRebuild(previous);
+    inheritSettings(&grown, table);
+    grown.compactionCount += !grow;
+    grown.previous = previous;
+    grown.migrateIndex = 0;
+    *table = grown;
+
+    if (DEBUG_MODE(mode)) {
+        printf("%s: eski boyut %d (%d aktif, %d silinmis), yeni boyut %d\n", grow ? "Buyume" : "Temizlik",
+               previous->size, liveCount, previous->deletedCount, newSize);
+    }
+    migrateStep(table);
+}
+
+/*
+@brief Bu fonksiyon, eski tablodaki bir elemani yeni tabloya tasir. Eski slot silinmis olarak isaretlenir ki eski tablodaki diger elemanlarin deneme dizileri bozulmasin.
+@param table -> buyuyen hash tablosu
+@param oldIndex -> eski tablodaki aktif slotun adresi
+@return elemanin yeni tablodaki adresi
+*/
+static int moveFromPrevious(HashTable *table, int oldIndex) {
+    HashTable *previous = table->previous;
+    char *userName = (char *)nameAt(previous, oldIndex);
+    NameRef ref = nameForTable(table, previous, oldIndex);
+    int index = placeOrEnlarge(table, userName, ref, tableSlotHash(table, userName));
+
+    setControl(previous, oldIndex, SLOT_DELETED);
+    previous->deletedCount++;
+    return index;
+}
+
+/*
+@brief Bu fonksiyon, tablo buyuyorsa eski tablonun en fazla migrateStep slotunu yeni tabloya tasir; eski tablo bitince serbest birakilir.
+@param table -> hash tablosu
+*/
+void migrateStep(HashTable *table) {
+    HashTable *previous = table->previous;
+    int step;
+
+    if (previous == NULL) return;
+
+    for (step = 0; step < table->migrateStep && table->migrateIndex < previous->size; step++, table->migrateIndex++) {
+        if (!EMPTY_ENTRY(previous, table->migrateIndex) && !DELETED_ENTRY(previous, table->migrateIndex)) {
+            moveFromPrevious(table, table->migrateIndex);
+        }
+    }
+    if (table->migrateIndex >= previous->size) {
+        freeHashTable(previous);
+        free(previous);
+        table->previous = NULL;
+        table->migrateIndex = 0;
+    }
+}
+
+/*
+@brief Bu fonksiyon, devam eden bir buyumeyi hemen bitirir. Tum tabloyu gezen islemlerden (rehash, duzenleme) once cagrilir.
+@param table -> hash tablosu
+*/
+void finishMigration(HashTable *table) {
+    int step = table->migrateStep;
+    table->migrateStep = INT_MAX;
+    migrateStep(table);
+    table->migrateStep = step;
+}
+
+/*
+@brief Bu fonksiyon, tablo buyurken ismi eski tabloda arar; bulursa hemen yeni tabloya tasir.
+@param table -> hash tablosu
+@param userName -> aranan kullanici adi
+@return elemanin yeni tablodaki adresi ya da RESULT_NOT_FOUND
+*/
+int takeFromPrevious(HashTable *table, char *userName) {
+    HashTable *previous = table->previous;
+    SlotHash hash;
+    int oldIndex;
+
+    if (previous == NULL) return RESULT_NOT_FOUND;
+
+    hash = tableSlotHash(previous, userName);
+    oldIndex = findSlot(previous, userName, "NORMAL", hash);
+    if (oldIndex == -1 || !slotHasName(previous, oldIndex, userName, hash)) {
+        return RESULT_NOT_FOUND;
+    }
+    return moveFromPrevious(table, oldIndex);
+}
+
+/*
+@brief Programın ana fonksiyonu. Kullanıcıdan giriş alır ve hash tablosu işlemlerini yönetir.
+*/
+int main(int argc, char *argv[]) {
+    int n, i;
+    float loadFactor;
+    char mode[10];
+    char action = '\0', userName[MAX_INPUT_LENGTH];
+    HashTable table;
+    int fixedSize = 0;
+    const char *snapshotPath = NULL;
+    int snapshotMode = SNAPSHOT_READ_ONLY;
+
+    if (argc >= 3 && strcmp(argv[1], "--bench-layout") == 0) {
+        benchmarkLayout(atoi(argv[2]), argc >= 4 ? (float)atof(argv[3]) : 0.75f);
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-grow") == 0) {
+        benchmarkGrowth(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--stress-concurrent") == 0) {
+        return stressConcurrent(atoi(argv[2]));
+    }
+    if (argc == 4 && strcmp(argv[1], "--bench-concurrent") == 0) {
+        benchmarkConcurrent(atoi(argv[2]), atoi(argv[3]));
+        return 0;
+    }
+    if (argc == 4 && strcmp(argv[1], "--bench-sharded") == 0) {
+        benchmarkSharded(atoi(argv[2]), atoi(argv[3]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-hash") == 0) {
+        benchmarkHash(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-batch") == 0) {
+        benchmarkBatch(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-filter") == 0) {
+        benchmarkFilter(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-churn") == 0) {
+        benchmarkChurn(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-names") == 0) {
+        benchmarkNames(atoi(argv[2]));
+        return 0;
+    }
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--replay") == 0) {
+        char replayMode[10] = "NORMAL";
+        if (argc == 4) {
+            for (i = 0; argv[3][i] != '\0' && i < 9; i++) replayMode[i] = (char)toupper((unsigned char)argv[3][i]);
+            replayMode[i] = '\0';
+            if (strcmp(replayMode, "NORMAL") != 0 && strcmp(replayMode, "DEBUG") != 0) {
+                fprintf(stderr, "gecersiz mod. Lutfen 'NORMAL' veya 'DEBUG' girin.\n");
+                return 1;
+            }
+        }
+        return replayCommands(argv[2], replayMode);
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-strategy") == 0) {
+        benchmarkStrategy(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--make-log") == 0) {
+        generateCommandLog(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 4 && strcmp(argv[1], "--bench-snapshot") == 0) {
+        benchmarkSnapshot(atoi(argv[2]), argv[3]);
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--fixed") == 0) {
+        fixedSize = 1;
+    } else if ((argc == 3 || (argc == 4 && strcmp(argv[3], "--cow") == 0)) && strcmp(argv[1], "--open") == 0) {
+        snapshotPath = argv[2];
+        snapshotMode = argc == 4 ? SNAPSHOT_COPY_ON_WRITE : SNAPSHOT_READ_ONLY;
+    } else if (argc > 1) {
+        fprintf(stderr, "Kullanim: %s [--fixed | --open dosya [--cow] | --bench-layout N [load factor] | --bench-grow N | --bench-hash N | --bench-batch N | --bench-churn N | --bench-filter N | --bench-names N | --bench-snapshot N dosya | --replay dosya|- [NORMAL|DEBUG] | --make-log N | --bench-strategy N | --stress-concurrent T | --bench-concurrent N T | --bench-sharded N T]\n", argv[0]);
+        return 1;
+    }
+
+    if (snapshotPath != NULL) {
+        // kayittan acilan tablonun boyutu ve load factor'u dosyadadir, N siniri yoktur
+        if (openSnapshot(snapshotPath, snapshotMode, &table) != 0) {
+            return 1;
+        }
+        n = INT_MAX;
+        printf("%s acildi: boyut %d, %d aktif eleman%s.\n", snapshotPath, table.size,
+               table.elementCount - table.deletedCount, table.readOnly ? ", salt okunur" : "");
+    } else {
+        printf("Tabloya eklemek istediginiz eleman sayisini girin: ");
+        scanf("%d", &n);
+    }
+
+    int loadFactorValid = snapshotPath != NULL;
+
+    while (!loadFactorValid) {
+        printf("Load factor degerini girin (pozitif bir sayi olmali): ");
+        if (scanf("%f", &loadFactor) == 1 && loadFactor > 0) {
+            loadFactorValid = 1; // Geçerli bir load factor girildi
+        } else {
+            printf("gecersiz load factor. Lutfen gecerli bir load factor degeri girin.\n");
+            while (getchar() != '\n'); // Geçersiz girişi temizle
+        }
+    }
+
+    if (snapshotPath == NULL) {
+        int tableSize = calculateTableSize(n, loadFactor);
+        printf("Tablonuzun boyutu %d olarak hesaplandi.\n", tableSize);
+        table = createHashTable(tableSize, loadFactor);
+        table.autoResize = !fixedSize;
+    }
+
+    int modeValid = 0;
+    while (!modeValid) {
+        printf("Modu girin (NORMAL/DEBUG): ");
+        scanf("%s", mode);
+
+        // Kullanıcının girdiği modu küçük harfe çevir
+        for ( i = 0; mode[i]; i++) {
+            mode[i] = toupper(mode[i]);
+        }
+
+        // Mod kontrolü
+        if (strcmp(mode, "NORMAL") == 0 || strcmp(mode, "DEBUG") == 0) {
+            modeValid = 1;
+        } else {
+            printf("gecersiz mod. Lutfen 'NORMAL' veya 'DEBUG' girin.\n");
+        }
+    }
+
+    int shouldExit = 0;
+
+    while (!shouldExit) {
+        printf("\nEkleme (e), Silme (s), Arama (a), Goruntule (g), Duzenle (d), Istatistik (i), Kaydet (k), Filtre (f), Cikis (q): ");
+        scanf(" %c", &action);
 
         switch (action) {
             case 'e':
                 printf("Eklemek istediginiz kullanicinin adini girin: ");
-                scanf("%s", userName);
+                scanf("%255s", userName);
                 insertEntry(&table, userName, mode, n);  
                 break;
-            case 's':
-                printf("Silmek istediginiz kullanicinin adini girin: ");
-                scanf("%s", userName);
-                deleteEntry(&table, userName, mode);
+            case 's':
+                printf("Silmek istediginiz kullanicinin adini girin: ");
+                scanf("%255s", userName);
+                deleteEntry(&table, userName, mode);
+                break;
+            case 'a':
+                printf("Aramak istediginiz kullanicinin adini girin: ");
+                scanf("%255s", userName);
+                searchEntry(&table, userName, mode);
+                break;
+            case 'g':
+                displayHashTable(&table);
+                break;
+            case 'd':
+                if (table.elementCount == 0 && table.previous == NULL) {
+                    printf("once tabloya eleman ekleyin ve sonra silin.\n");
+                } else if (!hasDeletedEntry(&table)) {
+                    printf("duzenlemeden önce tablodan en az bir eleman silin.\n");
+                } else {
+                    reorganizeTable(&table, mode);
+                }
+                break;
+            case 'i':
+                printTableStats(&table);
+                break;
+            case 'k':
+                printf("Tablonun kaydedilecegi dosyanin adini girin: ");
+                scanf("%255s", userName);
+                if (writeSnapshot(&table, userName) == 0) {
+                    printf("Tablo %s dosyasina kaydedildi.\n", userName);
+                }
+                break;
+            case 'f':
+                toggleFilter(&table);
+                break;
+            case 'q':
+                shouldExit = 1;
+                break;
+            default:
+                printf("Gecersiz islem. Lutfen gecerli bir komut girin.\n");
+        }
+    }
+
+
+    freeHashTable(&table);
+    return 0;
+}
+
+/*
+@brief Bu fonksiyon, toplu islemlerin ortak dongusudur. Isimler BATCH_WINDOW'luk pencerelerle islenir: penceredeki isimlerin hash'i hesaplanir ve ilk deneme slotlari onceden bellege cagirilir, sonra her isim icin tekli islemin hash'li surumu cagirilir. Pencere icinde tablo buyurse kalan isimlerin hash'i yeni boyuta gore tekrar hesaplanir.
+@param table -> hash tablosu
+@param userNames -> isimler
+@param count -> isim sayisi
+@param n -> ekleme icin maksimum eleman sayisi
+@param results -> her isim icin tekli islemin dondurecegi deger buraya yazilir
+@param operation -> BATCH_INSERT, BATCH_SEARCH ya da BATCH_DELETE
+*/
+static void runBatch(HashTable *table, char **userNames, int count, int n, int *results, BatchOperation operation) {
+    SlotHash hashes[BATCH_WINDOW];
+    char mode[] = "NORMAL";
+    int start, i;
+
+    for (start = 0; start < count; start += BATCH_WINDOW) {
+        int end = start + BATCH_WINDOW < count ? start + BATCH_WINDOW : count;
+        int hashedSize = table->size;
+
+        for (i = start; i < end; i++) {
+            SlotHash hash = tableSlotHash(table, userNames[i]);
+            hashes[i - start] = hash;
+            __builtin_prefetch(&table->control[hash.h1Value]);
+            __builtin_prefetch(&table->names[hash.h1Value]);
+        }
+        for (i = start; i < end; i++) {
+            SlotHash hash = table->size == hashedSize ? hashes[i - start] : tableSlotHash(table, userNames[i]);
+            switch (operation) {
+                case BATCH_INSERT:
+                    results[i] = insertNameHashed(table, userNames[i], mode, n, hash);
+                    break;
+                case BATCH_SEARCH:
+                    results[i] = searchNameHashed(table, userNames[i], mode, hash);
+                    break;
+                default:
+                    results[i] = deleteNameHashed(table, userNames[i], mode, hash);
+            }
+        }
+    }
+}
+
+/*
+@brief Bu fonksiyon, bir isim dizisini toplu olarak ekler, ekrana bir sey yazmaz.
+@param table -> Ekleme yapılacak hash tablosu
+@param userNames -> eklenecek isimler
+@param count -> isim sayisi
+@param n -> Maksimum eleman sayısı, sadece tablo buyumuyorsa kullanilir
+@param results -> her isim icin insertName'in dondurecegi deger (adres ya da RESULT_*)
+*/
+void insertBatch(HashTable *table, char **userNames, int count, int n, int *results) {
+    runBatch(table, userNames, count, n, results, BATCH_INSERT);
+}
+
+/*
+@brief Bu fonksiyon, bir isim dizisini toplu olarak arar, ekrana bir sey yazmaz.
+@param table -> Arama yapılacak hash tablosu
+@param userNames -> aranacak isimler
+@param count -> isim sayisi
+@param results -> her isim icin adresi ya da RESULT_NOT_FOUND
+*/
+void searchBatch(HashTable *table, char **userNames, int count, int *results) {
+    runBatch(table, userNames, count, 0, results, BATCH_SEARCH);
+}
+
+/*
+@brief Bu fonksiyon, bir isim dizisini toplu olarak siler, ekrana bir sey yazmaz.
+@param table -> Silme yapılacak hash tablosu
+@param userNames -> silinecek isimler
+@param count -> isim sayisi
+@param results -> her isim icin silinen adres ya da RESULT_NOT_FOUND
+*/
+void deleteBatch(HashTable *table, char **userNames, int count, int *results) {
+    runBatch(table, userNames, count, 0, results, BATCH_DELETE);
+}
+
+/*
+@brief Bu fonksiyon, tablonun durumunu hesaplar: aktif ve silinmis slot sayisi, silinmis slot orani ve her aktif elemanin bulunmasi icin kac slota (grup motorunda kac gruba) bakildigi. Tablo degistirilmez.
+@param table -> hash tablosu
+@return hesaplanan sayilar
+*/
+TableStats computeTableStats(HashTable *table) {
+    TableStats stats = {0, 0, 0, 0.0, 0.0, 0, table->compactionCount};
+    long long totalProbes = 0;
+    int i;
+
+    for (i = 0; i < table->size; i++) {
+        if (DELETED_ENTRY(table, i)) {
+            stats.tombstoneCount++;
+        } else if (!EMPTY_ENTRY(table, i)) {
+            long long probes = 0;
+            activeProbeCount = &probes;
+            char *userName = (char *)nameAt(table, i);
+            findSlot(table, userName, "NORMAL", tableSlotHash(table, userName));
+            activeProbeCount = NULL;
+            totalProbes += probes;
+            if (probes > stats.maxProbe) stats.maxProbe = probes;
+            stats.liveCount++;
+        }
+    }
+    if (table->previous != NULL) {
+        for (i = table->migrateIndex; i < table->previous->size; i++) {
+            stats.pendingCount += !EMPTY_ENTRY(table->previous, i) && !DELETED_ENTRY(table->previous, i);
+        }
+    }
+    stats.tombstoneRatio = table->size > 0 ? (double)stats.tombstoneCount / table->size : 0.0;
+    stats.meanProbe = stats.liveCount > 0 ? (double)totalProbes / stats.liveCount : 0.0;
+    return stats;
+}
+
+/*
+@brief Bu fonksiyon, menudeki 'i' komutudur, tablonun durumunu ekrana yazar.
+@param table -> hash tablosu
+*/
+void printTableStats(HashTable *table) {
+    TableStats stats = computeTableStats(table);
+
+    printf("Tablo boyutu: %d, aktif eleman: %d, silinmis slot: %d (%%%.1f)\n",
+           table->size, stats.liveCount, stats.tombstoneCount, 100.0 * stats.tombstoneRatio);
+    printf("Ortalama deneme: %.2f, en uzun deneme: %lld, temizlik sayisi: %d\n",
+           stats.meanProbe, stats.maxProbe, stats.compactionCount);
+    if (stats.pendingCount > 0) {
+        printf("Eski tabloda tasinmayi bekleyen eleman: %d\n", stats.pendingCount);
+    }
+    if (table->filter != NULL) {
+        CountingFilter *filter = table->filter;
+        long long used = 0, total = (long long)filter->blockCount * FILTER_BLOCK_BYTES * 2, k;
+        for (k = 0; k < total; k++) {
+            used += ((filter->counters[k >> 1] >> ((k & 1) * 4)) & 15) != 0;
+        }
+        // bir olmayan isim, FILTER_HASHES sayacinin hepsi dolu cikarsa tabloya gider
+        printf("Filtre: %d isim, %d KB, dolu sayac orani %%%.1f, tahmini yanlis pozitif orani %%%.2f\n",
+               filter->count, filter->blockCount * FILTER_BLOCK_BYTES / 1024, 100.0 * used / total,
+               100.0 * pow((double)used / total, FILTER_HASHES));
+    }
+}
+
+/*
+@brief Bu fonksiyon, olcumler icin monoton saatin degerini dondurur.
+@return saniye cinsinden zaman
+*/
+double getTimeInSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+@brief Bu fonksiyon, olcumler icin i sayisindan farkli uzunluklarda, birbirinden farkli bir kullanici adi uretir: karisik harflerden bir on ek ve i'nin 36'lik tabandaki yazilisi.
+@param buffer -> en az MAX_NAME_LENGTH byte'lik yer
+@param i -> ismin sirasi
+*/
+void makeUserName(char *buffer, unsigned long long i) {
+    unsigned long long mix = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    int prefixLength = 3 + (int)(mix >> 60) % 10;
+    int length = 0, k;
+    char digits[16];
+    int digitCount = 0;
+
+    for (k = 0; k < prefixLength; k++) {
+        buffer[length++] = (char)('a' + (mix >> (k * 5)) % 26);
+    }
+    do {
+        digits[digitCount++] = "0123456789abcdefghijklmnopqrstuvwxyz"[i % 36];
+        i /= 36;
+    } while (i > 0);
+    while (digitCount > 0) {
+        buffer[length++] = digits[--digitCount];
+    }
+    buffer[length] = '\0';
+}
+
+/*
+@brief Bu fonksiyon, eski duzendeki (HashEntry dizisi) findSlot'un DEBUG ciktisi olmayan kopyasidir, sadece olcum icin kullanilir.
+@param entries -> eski duzendeki tablo
+@param size -> tablonun boyutu
+@param userName -> aranan kullanici adi
+@return Bulunan yuva indeksi veya -1
+*/
+int legacyFindSlot(HashEntry *entries, int size, char *userName) {
+    unsigned long key = hornerHash(userName, size);
+    int h1Value = h1(key, size);
+    int h2Value = h2(key, size);
+    int i, index;
+
+    for (i = 0; i < size; i++) {
+        index = (h1Value + i * h2Value) % size;
+        if (entries[index].userName[0] == '\0' || entries[index].deleted || strcmp(entries[index].userName, userName) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+/*
+@brief Bu fonksiyon, ayni isimlerle doldurulan eski HashEntry dizisi ile yeni kontrol + anahtar dizisi duzeninin arama hizini olcer. Once tablodaki isimler (bulunan aramalar), sonra tabloda olmayan isimler (bulunamayan aramalar) aranir.
+@param n -> tabloya eklenecek isim sayisi
+@param loadFactor -> tablonun load factoru
+*/
+void benchmarkLayout(int n, float loadFactor) {
+    int size = calculateTableSize(n, loadFactor);
+    int rounds = n >= 1000000 ? 3 : 10;
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)2 * n * MAX_NAME_LENGTH);
+    HashEntry *legacy = (HashEntry *)calloc(size, sizeof(HashEntry));
+    HashTable table = createHashTable(size, loadFactor);
+    char mode[] = "NORMAL";
+    long long found[2][2] = {{0, 0}, {0, 0}};
+    double elapsed[2][2] = {{0, 0}, {0, 0}};
+    int i, round, layout, kind;
+
+    table.autoResize = 0; // iki duzen ayni boyutta karsilastirilir
+    for (i = 0; i < 2 * n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+    for (i = 0; i < n; i++) {
+        int index = legacyFindSlot(legacy, size, names[i]);
+        strcpy(legacy[index].userName, names[i]);
+        insertName(&table, names[i], mode, n);
+    }
+
+    for (round = 0; round < rounds; round++) {
+        for (layout = 0; layout < 2; layout++) {
+            for (kind = 0; kind < 2; kind++) {
+                char (*queries)[MAX_NAME_LENGTH] = names + (kind == 0 ? 0 : n);
+                double start = getTimeInSeconds();
+                long long hits = 0;
+                for (i = 0; i < n; i++) {
+                    if (layout == 0) {
+                        int index = legacyFindSlot(legacy, size, queries[i]);
+                        hits += index != -1 && legacy[index].userName[0] != '\0' && !legacy[index].deleted;
+                    } else {
+                        hits += searchName(&table, queries[i], mode) != RESULT_NOT_FOUND;
+                    }
+                }
+                elapsed[layout][kind] += getTimeInSeconds() - start;
+                found[layout][kind] += hits;
+            }
+        }
+    }
+
+    printf("N: %d, tablo boyutu: %d, load factor: %.2f, tur: %d, deneme motoru: %s\n", n, size, loadFactor, rounds, probeEngineName());
+    printf("Slot boyutu: eski duzen %zu byte, yeni duzen 1 byte kontrol + %zu byte NameRef (+ uzun isimler icin arena)\n", sizeof(HashEntry), sizeof(NameRef));
+    for (layout = 0; layout < 2; layout++) {
+        printf("%-36s bulunan: %8.2f M arama/s (%lld)  bulunamayan: %8.2f M arama/s (%lld)\n",
+               layout == 0 ? "Eski duzen (HashEntry dizisi)" : "Yeni duzen (kontrol + anahtar dizisi)",
+               (double)n * rounds / elapsed[layout][0] / 1e6, found[layout][0],
+               (double)n * rounds / elapsed[layout][1] / 1e6, found[layout][1]);
+    }
+
+    free(names);
+    free(legacy);
+    freeHashTable(&table);
+}
+
+/*
+@brief Bu fonksiyon, 11 slotluk bir tablodan baslayip N isim ekler ve buyumenin maliyetini olcer. Kademeli tasima (her islemde MIGRATE_STEP slot) ile buyume aninda eski tablonun tamamen tasinmasi karsilastirilir; en yavas tek ekleme tam yeniden kurmanin duraksamasini gosterir.
+@param n -> eklenecek isim sayisi
+*/
+void benchmarkGrowth(int n) {
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)n * MAX_NAME_LENGTH);
+    char mode[] = "NORMAL";
+    int i, strategy;
+
+    for (i = 0; i < n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+
+    printf("N: %d, baslangic boyutu: 11, load factor: 0.75, deneme motoru: %s\n", n, probeEngineName());
+    for (strategy = 0; strategy < 2; strategy++) {
+        HashTable table = createHashTable(11, 0.75f);
+        double worst = 0, start, total;
+        int found = 0;
+
+        table.migrateStep = strategy == 0 ? MIGRATE_STEP : INT_MAX;
+        start = getTimeInSeconds();
+        for (i = 0; i < n; i++) {
+            double before = getTimeInSeconds();
+            insertName(&table, names[i], mode, n);
+            double elapsed = getTimeInSeconds() - before;
+            if (elapsed > worst) worst = elapsed;
+        }
+        total = getTimeInSeconds() - start;
+        for (i = 0; i < n; i++) {
+            found += searchName(&table, names[i], mode) >= 0;
+        }
+
+        printf("%-30s toplam: %8.3f s  %8.2f M ekleme/s  en yavas ekleme: %10.1f us  son boyut: %d  bulunan: %d\n",
+               strategy == 0 ? "Kademeli tasima" : "Tek seferde tasima",
+               total, n / total / 1e6, worst * 1e6, table.size, found);
+        freeHashTable(&table);
+    }
+    free(names);
+}
+
+/*
+@brief Bu fonksiyon, eszamanli kullanim icin sabit boyutlu bos bir tablo olusturur.
+@param size -> tablonun boyutu, asal olmali
+@return olusturulan tablo
+*/
+ConcurrentTable *createConcurrentTable(int size) {
+    ConcurrentTable *table = (ConcurrentTable *)aligned_alloc(64, (sizeof(ConcurrentTable) + 63) / 64 * 64);
+    int i;
+
+    table->size = size;
+    table->control = (_Atomic unsigned char *)malloc((size_t)size * sizeof(*table->control));
+    table->version = (_Atomic unsigned int *)malloc((size_t)size * sizeof(*table->version));
+    table->userNames = (char (*)[MAX_NAME_LENGTH])malloc((size_t)size * MAX_NAME_LENGTH);
+    for (i = 0; i < size; i++) {
+        atomic_init(&table->control[i], SLOT_EMPTY);
+        atomic_init(&table->version[i], 0);
+    }
+    atomic_init(&table->liveCount, 0);
+    for (i = 0; i < LOCK_STRIPES; i++) {
+        pthread_mutex_init(&table->stripes[i].lock, NULL);
+    }
+    return table;
+}
+
+/*
+@brief Bu fonksiyon, eszamanli tabloyu serbest birakir. Tabloyu kullanan thread kalmamis olmali.
+@param table -> serbest birakilacak tablo
+*/
+void freeConcurrentTable(ConcurrentTable *table) {
+    int i;
+    for (i = 0; i < LOCK_STRIPES; i++) {
+        pthread_mutex_destroy(&table->stripes[i].lock);
+    }
+    free((void *)table->control);
+    free((void *)table->version);
+    free(table->userNames);
+    free(table);
+}
+
+/*
+@brief Bu fonksiyon, bir slottaki ismi kilitsiz okuyarak aranan isimle karsilastirir. Isim karsilastirma sirasinda baska bir yazar tarafindan degistirildiyse (slotun surumu degistiyse) karsilastirma tekrarlanir.
+@param table -> eszamanli tablo
+@param index -> slotun adresi
+@param userName -> aranan kullanici adi
+@return isim ayniysa 1, degilse 0
+*/
+static int concurrentNameEquals(ConcurrentTable *table, int index, char *userName) {
+    for (;;) {
+        unsigned int before = atomic_load_explicit(&table->version[index], memory_order_acquire);
+        int equal = 1, k;
+
+        if (before & 1) {
+            return 0; // isim yaziliyor, ekleme henuz tamamlanmadi
+        }
+        for (k = 0; k < MAX_NAME_LENGTH; k++) {
+            char c = __atomic_load_n(&table->userNames[index][k], __ATOMIC_RELAXED);
+            if (c != userName[k]) {
+                equal = 0;
+                break;
+            }
+            if (c == '\0') break;
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&table->version[index], memory_order_relaxed) == before) {
+            return equal;
+        }
+    }
+}
+
+/*
+@brief Bu fonksiyon, sahiplenilmis (SLOT_BUSY) bir slota ismi yazar ve slotu dolu olarak yayinlar.
+@param table -> eszamanli tablo
+@param index -> slotun adresi
+@param userName -> yazilacak kullanici adi
+@param fingerprint -> ismin parmak izi
+*/
+static void concurrentPublish(ConcurrentTable *table, int index, char *userName, unsigned char fingerprint) {
+    unsigned int version = atomic_load_explicit(&table->version[index], memory_order_relaxed);
+    int k;
+
+    atomic_store_explicit(&table->version[index], version + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for (k = 0; k < MAX_NAME_LENGTH; k++) {
+        __atomic_store_n(&table->userNames[index][k], userName[k], __ATOMIC_RELAXED);
+        if (userName[k] == '\0') break;
+    }
+    atomic_store_explicit(&table->version[index], version + 2, memory_order_release);
+    atomic_store_explicit(&table->control[index], fingerprint, memory_order_release);
+}
+
+/*
+@brief Bu fonksiyon, eszamanli tabloya bir isim ekler. Ismin kilidi alinir, deneme dizisinde isim aranir ve yoldaki ilk silinmis ya da bos slot CAS ile sahiplenilir. CAS basarisizsa slotu baska kilitteki bir yazar almistir, deneme tekrarlanir. Slotlar MAX_NAME_LENGTH byte oldugu icin daha uzun isimler kesilmeden reddedilir.
+@param table -> eszamanli tablo
+@param userName -> eklenecek kullanici adi
+@return Elemanin yerlestirildigi adres ya da RESULT_TABLE_FULL, RESULT_EXISTS, RESULT_TOO_LONG
+*/
+int concurrentInsert(ConcurrentTable *table, char *userName) {
+    SlotHash hash;
+    pthread_mutex_t *lock;
+    int result = RESULT_TABLE_FULL;
+
+    if (strnlen(userName, MAX_NAME_LENGTH) >= MAX_NAME_LENGTH) {
+        return RESULT_TOO_LONG; // slotta '\0' icin yer kalmaz, kesilen isim baska bir isimle karisabilir
+    }
+    hash = computeSlotHash(userName, table->size);
+    lock = &table->stripes[hash.h1Value % LOCK_STRIPES].lock;
+
+    pthread_mutex_lock(lock);
+    for (;;) {
+        int index = hash.h1Value, target = -1, i;
+        unsigned char expected;
+
+        for (i = 0; i < table->size; i++) {
+            unsigned char control = atomic_load_explicit(&table->control[index], memory_order_acquire);
+            if (control == SLOT_EMPTY) {
+                if (target == -1) target = index;
                 break;
-            case 'a':
-                printf("Aramak istediginiz kullanicinin adini girin: ");
-                scanf("%s", userName);
-                searchEntry(&table, userName, mode);
+            }
+            if (control == SLOT_DELETED) {
+                if (target == -1) target = index;
+            } else if (control == hash.fingerprint && concurrentNameEquals(table, index, userName)) {
+                target = RESULT_EXISTS;
                 break;
-            case 'g':
-                displayHashTable(&table);
+            }
+            index = (index + hash.h2Value) % table->size;
+        }
+        if (target < 0) {
+            result = target == RESULT_EXISTS ? RESULT_EXISTS : RESULT_TABLE_FULL;
+            break;
+        }
+
+        expected = atomic_load_explicit(&table->control[target], memory_order_relaxed);
+        if ((expected == SLOT_EMPTY || expected == SLOT_DELETED) &&
+            atomic_compare_exchange_strong(&table->control[target], &expected, SLOT_BUSY)) {
+            concurrentPublish(table, target, userName, hash.fingerprint);
+            atomic_fetch_add_explicit(&table->liveCount, 1, memory_order_relaxed);
+            result = target;
+            break;
+        }
+    }
+    pthread_mutex_unlock(lock);
+    return result;
+}
+
+/*
+@brief Bu fonksiyon, eszamanli tablodan bir ismi siler. Ismin slotunu sadece ayni kilidi alan yazarlar degistirebilir, bu yuzden slot dogrudan silinmis olarak isaretlenir.
+@param table -> eszamanli tablo
+@param userName -> silinecek kullanici adi
+@return Silinen elemanin adresi ya da RESULT_NOT_FOUND
+*/
+int concurrentDelete(ConcurrentTable *table, char *userName) {
+    SlotHash hash = computeSlotHash(userName, table->size);
+    pthread_mutex_t *lock = &table->stripes[hash.h1Value % LOCK_STRIPES].lock;
+    int index = hash.h1Value, result = RESULT_NOT_FOUND, i;
+
+    pthread_mutex_lock(lock);
+    for (i = 0; i < table->size; i++) {
+        unsigned char control = atomic_load_explicit(&table->control[index], memory_order_acquire);
+        if (control == SLOT_EMPTY) break;
+        if (control == hash.fingerprint && concurrentNameEquals(table, index, userName)) {
+            atomic_store_explicit(&table->control[index], SLOT_DELETED, memory_order_release);
+            atomic_fetch_sub_explicit(&table->liveCount, 1, memory_order_relaxed);
+            result = index;
+            break;
+        }
+        index = (index + hash.h2Value) % table->size;
+    }
+    pthread_mutex_unlock(lock);
+    return result;
+}
+
+/*
+@brief Bu fonksiyon, eszamanli tabloda kilit almadan bir isim arar. Silinmis ve sahiplenilmis slotlar aramayi durdurmaz, arama ilk bos slotta biter.
+@param table -> eszamanli tablo
+@param userName -> aranan kullanici adi
+@return Elemanin adresi ya da RESULT_NOT_FOUND
+*/
+int concurrentSearch(ConcurrentTable *table, char *userName) {
+    SlotHash hash = computeSlotHash(userName, table->size);
+    int index = hash.h1Value, i;
+
+    for (i = 0; i < table->size; i++) {
+        unsigned char control = atomic_load_explicit(&table->control[index], memory_order_acquire);
+        if (control == SLOT_EMPTY) break;
+        if (control == hash.fingerprint && concurrentNameEquals(table, index, userName)) {
+            return index;
+        }
+        index = (index + hash.h2Value) % table->size;
+    }
+    return RESULT_NOT_FOUND;
+}
+
+// zorlama testinin ve olcumun thread'lere verdigi is
+typedef struct {
+    ConcurrentTable *table;
+    char (*names)[MAX_NAME_LENGTH];
+    int nameCount;
+    int threadCount;
+    int threadId;
+    int phase; // zorlama testinde 0: kendi isimleri, 1: ortak ekleme, 2: ortak silme
+    int operations;
+    int readPercent;
+    char *present; // isimlerin beklenen durumu, ilk asamada her thread sadece kendi isimlerini yazar
+    atomic_int *wins; // ortak asamalarda her ismi kac thread'in ekleyebildigi ya da silebildigi
+    atomic_int *errors;
+    double elapsed;
+} ConcurrentJob;
+
+/*
+@brief Bu fonksiyon, thread'e ozel splitmix64 uretecinden bir sonraki sayiyi dondurur.
+@param state -> uretecin durumu
+@return 64 bitlik rastgele sayi
+*/
+static uint64_t nextConcurrentRandom(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*
+@brief Bu fonksiyon, zorlama testinin bir thread'idir. Ilk asamada sadece kendi isimleri (sira % threadCount == threadId) uzerinde rastgele ekleme, silme ve arama yapar ve her sonucu modelle karsilastirir; arada baska thread'lerin isimlerini de kilitsiz arar. Ortak asamalarda tum isimleri farkli bir siradan baslayarak ekler ya da siler.
+@param argument -> ConcurrentJob
+@return NULL
+*/
+static void *stressWorker(void *argument) {
+    ConcurrentJob *job = (ConcurrentJob *)argument;
+    uint64_t state = 0x1234567ULL + (uint64_t)job->threadId * 7919;
+    int n = job->nameCount, op, i;
+
+    if (job->phase != 0) {
+        for (i = 0; i < n; i++) {
+            int k = (i + job->threadId * (n / job->threadCount)) % n;
+            int result = job->phase == 1 ? concurrentInsert(job->table, job->names[k]) : concurrentDelete(job->table, job->names[k]);
+            if (result >= 0) atomic_fetch_add(&job->wins[k], 1);
+        }
+        return NULL;
+    }
+
+    for (op = 0; op < job->operations; op++) {
+        uint64_t random = nextConcurrentRandom(&state);
+        int owned = (int)((random >> 2) % (uint64_t)((n - job->threadId + job->threadCount - 1) / job->threadCount));
+        int k = owned * job->threadCount + job->threadId;
+        int result;
+
+        switch (random & 3) {
+            case 0:
+                result = concurrentInsert(job->table, job->names[k]);
+                if (job->present[k] ? result != RESULT_EXISTS : result < 0) atomic_fetch_add(job->errors, 1);
+                if (result >= 0) job->present[k] = 1;
                 break;
-            case 'd':
-                if (table.elementCount == 0) {
-                    printf("once tabloya eleman ekleyin ve sonra silin.\n");
-                } else if (!hasDeletedEntry(&table)) {
-                    printf("duzenlemeden önce tablodan en az bir eleman silin.\n");
-                } else {
-                    reorganizeTable(&table, mode);
+            case 1:
+                result = concurrentDelete(job->table, job->names[k]);
+                if ((result >= 0) != job->present[k]) atomic_fetch_add(job->errors, 1);
+                if (result >= 0) job->present[k] = 0;
+                break;
+            case 2:
+                result = concurrentSearch(job->table, job->names[k]);
+                if ((result >= 0) != job->present[k]) atomic_fetch_add(job->errors, 1);
+                break;
+            default:
+                // baska thread'lerin degistirdigi isimler, sonucu bilinemez ama okuyucu yazarlarla yarismis olur
+                concurrentSearch(job->table, job->names[(random >> 2) % (uint64_t)n]);
+        }
+    }
+    return NULL;
+}
+
+/*
+@brief Bu fonksiyon, tum thread'ler bittikten sonra tabloyu beklenen durumla karsilastirir: her isim beklendigi gibi bulunmali ve tablodaki dolu slot sayisi beklenen isim sayisina esit olmali.
+@param table -> eszamanli tablo
+@param names -> tum isimler
+@param present -> her ismin beklenen durumu
+@param n -> isim sayisi
+@return bulunan hata sayisi
+*/
+static int verifyConcurrentTable(ConcurrentTable *table, char (*names)[MAX_NAME_LENGTH], char *present, int n) {
+    int errors = 0, occupied = 0, expected = 0, i;
+
+    for (i = 0; i < table->size; i++) {
+        unsigned char control = atomic_load(&table->control[i]);
+        if (control == SLOT_BUSY) errors++;
+        if (control != SLOT_EMPTY && control != SLOT_DELETED) occupied++;
+    }
+    for (i = 0; i < n; i++) {
+        if ((concurrentSearch(table, names[i]) >= 0) != present[i]) errors++;
+        expected += present[i];
+    }
+    if (occupied != expected || atomic_load(&table->liveCount) != expected) errors++;
+    return errors;
+}
+
+/*
+@brief Bu fonksiyon, thread'leri baslatir ve hepsinin bitmesini bekler.
+@param jobs -> her thread'in isi (ConcurrentJob ya da ShardedJob dizisi)
+@param jobSize -> dizinin bir elemaninin boyutu
+@param threadCount -> thread sayisi
+@param function -> thread fonksiyonu
+*/
+static void runConcurrentJobs(void *jobs, size_t jobSize, int threadCount, void *(*function)(void *)) {
+    pthread_t *threads = (pthread_t *)malloc(threadCount * sizeof(pthread_t));
+    int i;
+
+    for (i = 0; i < threadCount; i++) {
+        pthread_create(&threads[i], NULL, function, (char *)jobs + (size_t)i * jobSize);
+    }
+    for (i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+}
+
+/*
+@brief Bu fonksiyon, eszamanli tabloyu threadCount thread ile uc asamada zorlar ve her asamadan sonra tabloyu dogrular: kendi isimleri uzerinde rastgele islemler, tum thread'lerin ayni isimleri eklemesi (her isim tam bir kez eklenmeli) ve ayni isimleri silmesi (her isim tam bir kez silinmeli).
+@param threadCount -> thread sayisi
+@return hata yoksa 0, varsa 1 (programin cikis kodu)
+*/
+int stressConcurrent(int threadCount) {
+    int n = 20000, operations = 200000, phase, i, errors = 0;
+    ConcurrentTable *table = createConcurrentTable(calculateTableSize(n, 0.5f));
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)n * MAX_NAME_LENGTH);
+    char *present = (char *)calloc(n, 1);
+    atomic_int *wins = (atomic_int *)malloc((size_t)n * sizeof(atomic_int));
+    atomic_int workerErrors;
+    ConcurrentJob *jobs;
+
+    if (threadCount < 1) threadCount = 1;
+    jobs = (ConcurrentJob *)malloc(threadCount * sizeof(ConcurrentJob));
+    atomic_init(&workerErrors, 0);
+    for (i = 0; i < n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+
+    for (phase = 0; phase < 3; phase++) {
+        int wrongWins = 0;
+
+        if (phase == 1) {
+            // ilk asamadan kalan isimler tek thread ile silinir, ortak asamalar bos tabloyla baslar
+            for (i = 0; i < n; i++) {
+                if (present[i]) concurrentDelete(table, names[i]);
+            }
+        }
+        for (i = 0; i < n; i++) {
+            atomic_init(&wins[i], 0);
+        }
+        for (i = 0; i < threadCount; i++) {
+            jobs[i].table = table;
+            jobs[i].names = names;
+            jobs[i].nameCount = n;
+            jobs[i].threadCount = threadCount;
+            jobs[i].threadId = i;
+            jobs[i].phase = phase;
+            jobs[i].operations = operations;
+            jobs[i].readPercent = 0;
+            jobs[i].present = present;
+            jobs[i].wins = wins;
+            jobs[i].errors = &workerErrors;
+        }
+        runConcurrentJobs(jobs, sizeof(ConcurrentJob), threadCount, stressWorker);
+
+        if (phase != 0) {
+            for (i = 0; i < n; i++) {
+                present[i] = phase == 1;
+                wrongWins += atomic_load(&wins[i]) != 1;
+            }
+        }
+        int tableErrors = verifyConcurrentTable(table, names, present, n);
+        printf("Asama %d (%s): thread hatasi: %d, tekrar ya da kayip: %d, tablo hatasi: %d\n", phase + 1,
+               phase == 0 ? "kendi isimleri" : phase == 1 ? "ortak ekleme" : "ortak silme",
+               atomic_load(&workerErrors), wrongWins, tableErrors);
+        errors += atomic_load(&workerErrors) + wrongWins + tableErrors;
+        atomic_store(&workerErrors, 0);
+    }
+    printf("%d thread, %d isim: %s\n", threadCount, n, errors == 0 ? "basarili" : "HATALI");
+
+    free(jobs);
+    free(wins);
+    free(present);
+    free(names);
+    freeConcurrentTable(table);
+    return errors == 0 ? 0 : 1;
+}
+
+/*
+@brief Bu fonksiyon, olcumun bir thread'idir. Her islemde readPercent olasilikla bir arama, kalan durumlarda yari yariya ekleme ya da silme yapar. Isimler 2N'lik havuzdan secilir, boylece tablo yaklasik yari dolu kalir.
+@param argument -> ConcurrentJob
+@return NULL
+*/
+static void *benchmarkWorker(void *argument) {
+    ConcurrentJob *job = (ConcurrentJob *)argument;
+    uint64_t state = 0xC0FFEEULL + (uint64_t)job->threadId * 104729;
+    double start = getTimeInSeconds();
+    int op;
+
+    for (op = 0; op < job->operations; op++) {
+        uint64_t random = nextConcurrentRandom(&state);
+        char *name = job->names[(random >> 8) % (uint64_t)job->nameCount];
+
+        if ((int)(random % 100) < job->readPercent) {
+            concurrentSearch(job->table, name);
+        } else if (random & 128) {
+            concurrentInsert(job->table, name);
+        } else {
+            concurrentDelete(job->table, name);
+        }
+    }
+    job->elapsed = getTimeInSeconds() - start;
+    return NULL;
+}
+
+/*
+@brief Bu fonksiyon, N isimle doldurulan eszamanli tabloda 1'den maxThreads'e kadar (ikinin kuvvetleri ve maxThreads) thread sayilarinda ve %99, %90, %75, %50 okuma oranlarinda toplam islem hizini olcer. Her olcum yeni doldurulmus bir tabloyla baslar.
+@param n -> tabloya baslangicta eklenen isim sayisi
+@param maxThreads -> en fazla thread sayisi
+*/
+void benchmarkConcurrent(int n, int maxThreads) {
+    static const int readPercents[] = {99, 90, 75, 50};
+    int totalOperations = 4000000, size = calculateTableSize(2 * n, 0.5f);
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)2 * n * MAX_NAME_LENGTH);
+    ConcurrentJob *jobs;
+    int mix, threads, i;
+
+    if (maxThreads < 1) maxThreads = 1;
+    jobs = (ConcurrentJob *)malloc(maxThreads * sizeof(ConcurrentJob));
+    for (i = 0; i < 2 * n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+
+    printf("N: %d, isim havuzu: %d, tablo boyutu: %d, kilit sayisi: %d, toplam islem: %d\n", n, 2 * n, size, LOCK_STRIPES, totalOperations);
+    printf("%-8s", "thread");
+    for (mix = 0; mix < 4; mix++) {
+        printf("  %%%d okuma (M islem/s)", readPercents[mix]);
+    }
+    printf("\n");
+
+    for (threads = 1;; threads *= 2) {
+        if (threads > maxThreads) threads = maxThreads;
+        printf("%-8d", threads);
+        for (mix = 0; mix < 4; mix++) {
+            ConcurrentTable *table = createConcurrentTable(size);
+            double slowest = 0;
+
+            for (i = 0; i < n; i++) {
+                concurrentInsert(table, names[2 * i]);
+            }
+            for (i = 0; i < threads; i++) {
+                jobs[i].table = table;
+                jobs[i].names = names;
+                jobs[i].nameCount = 2 * n;
+                jobs[i].threadCount = threads;
+                jobs[i].threadId = i;
+                jobs[i].operations = totalOperations / threads;
+                jobs[i].readPercent = readPercents[mix];
+            }
+            runConcurrentJobs(jobs, sizeof(ConcurrentJob), threads, benchmarkWorker);
+            for (i = 0; i < threads; i++) {
+                if (jobs[i].elapsed > slowest) slowest = jobs[i].elapsed;
+            }
+            printf("  %21.2f", (double)(totalOperations / threads) * threads / slowest / 1e6);
+            freeConcurrentTable(table);
+        }
+        printf("\n");
+        if (threads == maxThreads) break;
+    }
+
+    free(jobs);
+    free(names);
+}
+
+/*
+@brief Bu fonksiyon, 2^shardBits parcali bir tablo olusturur. Her parca n / 2^shardBits isim alacak boyutta acilir, sonra kendi basina buyur ve temizlenir. Parcalarin hashShift'i shardBits'tir, boylece parcayi secen bitler parcanin icindeki adresi etkilemez.
+@param shardBits -> parca sayisinin ikili logaritmasi, 0 ile MAX_SHARD_BITS arasina cekilir
+@param n -> tabloya beklenen toplam isim sayisi
+@param loadFactor -> her parcanin load factoru
+@return olusturulan tablo
+*/
+ShardedTable *createShardedTable(int shardBits, int n, float loadFactor) {
+    ShardedTable *table = (ShardedTable *)malloc(sizeof(ShardedTable));
+    int perShard, i;
+
+    if (shardBits < 0) shardBits = 0;
+    if (shardBits > MAX_SHARD_BITS) shardBits = MAX_SHARD_BITS;
+    table->shardBits = shardBits;
+    table->shardCount = 1 << shardBits;
+    perShard = n / table->shardCount + 1;
+    if (perShard < MIN_TABLE_SIZE) perShard = MIN_TABLE_SIZE;
+    // sizeof(TableShard) 64'un kati oldugu icin her parca ayri bir cache satirindan baslar
+    table->shards = (TableShard *)aligned_alloc(64, (size_t)table->shardCount * sizeof(TableShard));
+    for (i = 0; i < table->shardCount; i++) {
+        pthread_mutex_init(&table->shards[i].lock, NULL);
+        table->shards[i].table = createHashTable(calculateTableSize(perShard, loadFactor), loadFactor);
+        table->shards[i].table.hashShift = shardBits;
+    }
+    return table;
+}
+
+/*
+@brief Bu fonksiyon, parcali tabloyu ve tum parcalarini free eder.
+@param table -> parcali tablo
+*/
+void freeShardedTable(ShardedTable *table) {
+    int i;
+
+    for (i = 0; i < table->shardCount; i++) {
+        pthread_mutex_destroy(&table->shards[i].lock);
+        freeHashTable(&table->shards[i].table);
+    }
+    free(table->shards);
+    free(table);
+}
+
+/*
+@brief Bu fonksiyon, parcali tablodaki ekleme, silme ve aramanin ortak kismidir. Ismin hash'i kilit disinda bir kez hesaplanir, ust shardBits biti parcayi secer; parcanin boyutu baska bir thread'in eklemesiyle degisebilecegi icin h1 ve h2 kilit alindiktan sonra cikarilir. Parcanin icinde tekli islemin hash'li surumu calisir, buyume ve temizlik sadece o parcada olur.
+@param table -> parcali tablo
+@param userName -> kullanici adi
+@param operation -> BATCH_INSERT, BATCH_SEARCH ya da BATCH_DELETE
+@return parcanin icindeki adres ya da tekli islemin RESULT_ degeri
+*/
+static int shardedOperation(ShardedTable *table, char *userName, BatchOperation operation) {
+    size_t length = strlen(userName);
+    uint64_t value = wordHash(userName, length);
+    TableShard *shard = &table->shards[table->shardBits > 0 ? value >> (64 - table->shardBits) : 0];
+    char mode[] = "NORMAL";
+    SlotHash hash;
+    int result;
+
+    pthread_mutex_lock(&shard->lock);
+    hash = slotHashFromValue(value, (int)length, shard->table.size, table->shardBits);
+    switch (operation) {
+        case BATCH_INSERT:
+            result = insertNameHashed(&shard->table, userName, mode, 0, hash);
+            break;
+        case BATCH_SEARCH:
+            result = searchNameHashed(&shard->table, userName, mode, hash);
+            break;
+        default:
+            result = deleteNameHashed(&shard->table, userName, mode, hash);
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return result;
+}
+
+/*
+@brief Bu fonksiyon, parcali tabloya bir isim ekler; farkli parcalara dusen eklemeler birbirini beklemez.
+@param table -> parcali tablo
+@param userName -> eklenecek isim
+@return parcanin icindeki adres ya da RESULT_EXISTS
+*/
+int shardedInsert(ShardedTable *table, char *userName) {
+    return shardedOperation(table, userName, BATCH_INSERT);
+}
+
+/*
+@brief Bu fonksiyon, parcali tablodan bir ismi siler.
+@param table -> parcali tablo
+@param userName -> silinecek isim
+@return silinen adres ya da RESULT_NOT_FOUND
+*/
+int shardedDelete(ShardedTable *table, char *userName) {
+    return shardedOperation(table, userName, BATCH_DELETE);
+}
+
+/*
+@brief Bu fonksiyon, parcali tabloda bir ismi arar.
+@param table -> parcali tablo
+@param userName -> aranan isim
+@return bulunan adres ya da RESULT_NOT_FOUND
+*/
+int shardedSearch(ShardedTable *table, char *userName) {
+    return shardedOperation(table, userName, BATCH_SEARCH);
+}
+
+/*
+@brief Bu fonksiyon, tum parcalarin durumunu toplar: sayilar toplanir, ortalama deneme aktif eleman sayisiyla agirliklandirilir, silinmis slot orani toplam boyuta gore hesaplanir. computeTableStats gibi activeProbeCount'u kullandigi icin baska thread'ler tabloyu kullanirken cagrilmamalidir.
+@param table -> parcali tablo
+@return toplanan sayilar
+*/
+TableStats computeShardedStats(ShardedTable *table) {
+    TableStats total = {0, 0, 0, 0.0, 0.0, 0, 0};
+    double probeSum = 0;
+    long long size = 0;
+    int i;
+
+    for (i = 0; i < table->shardCount; i++) {
+        TableStats stats = computeTableStats(&table->shards[i].table);
+        total.liveCount += stats.liveCount;
+        total.tombstoneCount += stats.tombstoneCount;
+        total.pendingCount += stats.pendingCount;
+        total.compactionCount += stats.compactionCount;
+        if (stats.maxProbe > total.maxProbe) total.maxProbe = stats.maxProbe;
+        probeSum += stats.meanProbe * stats.liveCount;
+        size += table->shards[i].table.size;
+    }
+    total.tombstoneRatio = size > 0 ? (double)total.tombstoneCount / size : 0.0;
+    total.meanProbe = total.liveCount > 0 ? probeSum / total.liveCount : 0.0;
+    return total;
+}
+
+/*
+@brief Bu fonksiyon, parcali tablonun toplam durumunu ve parcalar arasindaki dengesizligi (en az ve en cok elemanli parca) ekrana yazar.
+@param table -> parcali tablo
+*/
+void printShardedStats(ShardedTable *table) {
+    TableStats stats = computeShardedStats(table);
+    long long size = 0;
+    int fewest = INT_MAX, most = 0, i;
+
+    for (i = 0; i < table->shardCount; i++) {
+        HashTable *shard = &table->shards[i].table;
+        int live = shard->elementCount - shard->deletedCount;
+        if (shard->previous != NULL) live += shard->previous->elementCount - shard->previous->deletedCount;
+        if (live < fewest) fewest = live;
+        if (live > most) most = live;
+        size += shard->size;
+    }
+    printf("Parca sayisi: %d, toplam boyut: %lld, parca basina aktif eleman: en az %d, en cok %d\n",
+           table->shardCount, size, fewest, most);
+    printf("Aktif eleman: %d, silinmis slot: %d (%%%.1f), tasinmayi bekleyen: %d\n",
+           stats.liveCount + stats.pendingCount, stats.tombstoneCount, 100.0 * stats.tombstoneRatio, stats.pendingCount);
+    printf("Ortalama deneme: %.2f, en uzun deneme: %lld, temizlik sayisi: %d\n",
+           stats.meanProbe, stats.maxProbe, stats.compactionCount);
+}
+
+/*
+@brief Bu fonksiyon, parcali tablonun icerigini parca parca displayHashTable ile yazdirir; adresler parcanin icindeki adreslerdir.
+@param table -> parcali tablo
+*/
+void displayShardedTable(ShardedTable *table) {
+    int i;
+
+    for (i = 0; i < table->shardCount; i++) {
+        printf("\n--- Parca %d / %d ---", i, table->shardCount);
+        displayHashTable(&table->shards[i].table);
+    }
+}
+
+// parcali tablo olcumunde bir thread'in isi
+typedef struct {
+    ShardedTable *table;
+    char (*names)[MAX_NAME_LENGTH];
+    int nameCount;
+    int threadCount;
+    int threadId;
+    BatchOperation operation;
+    int successes; // basarili ekleme ya da bulunan arama sayisi
+    double elapsed;
+} ShardedJob;
+
+/*
+@brief Bu fonksiyon, parcali tablo olcumunun bir thread'idir: sira % threadCount == threadId olan isimleri ekler ya da arar.
+@param argument -> ShardedJob
+@return NULL
+*/
+static void *shardedWorker(void *argument) {
+    ShardedJob *job = (ShardedJob *)argument;
+    double start = getTimeInSeconds();
+    int successes = 0, i;
+
+    for (i = job->threadId; i < job->nameCount; i += job->threadCount) {
+        int result = job->operation == BATCH_INSERT ? shardedInsert(job->table, job->names[i]) : shardedSearch(job->table, job->names[i]);
+        successes += result >= 0;
+    }
+    job->successes = successes;
+    job->elapsed = getTimeInSeconds() - start;
+    return NULL;
+}
+
+/*
+@brief Bu fonksiyon, parcali tabloya N ismin 1'den maxThreads'e kadar (ikinin kuvvetleri ve maxThreads) thread ile eklenme ve sonra aranma hizini 1, 4, 16 ve 64 parca icin olcer. Tablo kucuk baslar, parcalar eklemeler sirasinda kendi baslarina buyur. Tek parca, tum thread'lerin tek kilitte beklemesi demektir ve karsilastirmanin tabanidir. Her olcumden sonra tum eklemelerin basarili oldugu ve tum isimlerin bulundugu kontrol edilir.
+@param n -> eklenecek isim sayisi
+@param maxThreads -> en fazla thread sayisi
+*/
+void benchmarkSharded(int n, int maxThreads) {
+    static const int shardBits[] = {0, 2, 4, 6};
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)n * MAX_NAME_LENGTH);
+    ShardedJob *jobs;
+    int threads, b, i, errors = 0;
+
+    if (maxThreads < 1) maxThreads = 1;
+    jobs = (ShardedJob *)malloc(maxThreads * sizeof(ShardedJob));
+    for (i = 0; i < n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+
+    printf("N: %d, baslangic kapasitesi: 1024 isim, load factor: 0.75, motor: %s\n", n, probeEngineName());
+    printf("%-8s", "thread");
+    for (b = 0; b < 4; b++) {
+        printf("  %2d parca: M ekleme/s  M arama/s", 1 << shardBits[b]);
+    }
+    printf("\n");
+
+    for (threads = 1;; threads *= 2) {
+        if (threads > maxThreads) threads = maxThreads;
+        printf("%-8d", threads);
+        for (b = 0; b < 4; b++) {
+            ShardedTable *table = createShardedTable(shardBits[b], 1024, 0.75f);
+            double rates[2];
+            int phase;
+
+            for (phase = 0; phase < 2; phase++) {
+                double slowest = 0;
+                int successes = 0;
+
+                for (i = 0; i < threads; i++) {
+                    jobs[i].table = table;
+                    jobs[i].names = names;
+                    jobs[i].nameCount = n;
+                    jobs[i].threadCount = threads;
+                    jobs[i].threadId = i;
+                    jobs[i].operation = phase == 0 ? BATCH_INSERT : BATCH_SEARCH;
                 }
+                runConcurrentJobs(jobs, sizeof(ShardedJob), threads, shardedWorker);
+                for (i = 0; i < threads; i++) {
+                    if (jobs[i].elapsed > slowest) slowest = jobs[i].elapsed;
+                    successes += jobs[i].successes;
+                }
+                errors += successes != n;
+                rates[phase] = n / slowest / 1e6;
+            }
+            printf("  %21.2f  %9.2f", rates[0], rates[1]);
+            if (threads == maxThreads && b == 3) {
+                printf("\n\nSon tablo (%d thread, %d parca):\n", threads, 1 << shardBits[b]);
+                printShardedStats(table);
+            }
+            freeShardedTable(table);
+        }
+        printf("\n");
+        if (threads == maxThreads) break;
+    }
+    printf("Dogrulama: %s\n", errors == 0 ? "tum eklemeler basarili, tum isimler bulundu" : "HATALI");
+
+    free(jobs);
+    free(names);
+}
+
+/*
+@brief Bu fonksiyon, Horner ve 64 bitlik hash'i karsilastirir: once N ismin h1, h2 ve parmak izinin hesaplanma hizi, sonra 0.5, 0.75 ve 0.9 load factorlu tablolarda bulunan ve bulunamayan aramalarin kac slota (grup motorunda kac gruba) baktigi. Tablolar ayni isimlerle, sadece hash fonksiyonu degistirilerek doldurulur.
+@param n -> isim sayisi
+*/
+void benchmarkHash(int n) {
+    static const float loadFactors[] = {0.5f, 0.75f, 0.9f};
+    static const char *bucketNames[] = {"1", "2", "3", "4", "5-8", "9-16", ">16"};
+    SlotHash (*functions[2])(char *, int) = {hornerSlotHash, computeSlotHash};
+    const char *functionNames[2] = {"Horner", "64 bit"};
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)2 * n * MAX_NAME_LENGTH);
+    char mode[] = "NORMAL";
+    long long totalBytes = 0;
+    int rounds = 10, function, lf, round, i, b;
+
+    for (i = 0; i < 2 * n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+        if (i < n) totalBytes += (long long)strlen(names[i]);
+    }
+
+    printf("N: %d, ortalama isim uzunlugu: %.1f, deneme motoru: %s\n", n, (double)totalBytes / n, probeEngineName());
+    for (function = 0; function < 2; function++) {
+        int size = calculateTableSize(n, 0.75f);
+        unsigned int checksum = 0;
+        double start = getTimeInSeconds(), elapsed;
+
+        for (round = 0; round < rounds; round++) {
+            for (i = 0; i < n; i++) {
+                SlotHash hash = functions[function](names[i], size);
+                checksum += (unsigned int)(hash.h1Value ^ hash.h2Value ^ hash.fingerprint);
+            }
+        }
+        elapsed = getTimeInSeconds() - start;
+        printf("%-8s hiz: %8.2f M hash/s  %8.1f MB/s  (kontrol: %u)\n", functionNames[function],
+               (double)n * rounds / elapsed / 1e6, (double)totalBytes * rounds / elapsed / 1e6, checksum);
+    }
+
+    for (lf = 0; lf < 3; lf++) {
+        int size = calculateTableSize(n, loadFactors[lf]);
+        printf("\nload factor: %.2f, tablo boyutu: %d\n", loadFactors[lf], size);
+        printf("%-8s %-11s %6s %6s", "hash", "arama", "ort.", "max");
+        for (b = 0; b < 7; b++) printf(" %7s", bucketNames[b]);
+        printf("\n");
+
+        for (function = 0; function < 2; function++) {
+            HashTable table = createHashTable(size, loadFactors[lf]);
+            int kind;
+
+            for (i = 0; i < n; i++) {
+                SlotHash hash = functions[function](names[i], size);
+                int index = findSlot(&table, names[i], mode, hash);
+                table.names[index] = storeName(table.arena, names[i], hash.length);
+                setControl(&table, index, hash.fingerprint);
+                table.elementCount++;
+            }
+            for (kind = 0; kind < 2; kind++) {
+                long long histogram[7] = {0}, total = 0, longest = 0;
+
+                for (i = 0; i < n; i++) {
+                    long long probes = 0;
+                    char *name = names[kind == 0 ? i : n + i];
+                    activeProbeCount = &probes;
+                    findSlot(&table, name, mode, functions[function](name, size));
+                    activeProbeCount = NULL;
+                    total += probes;
+                    if (probes > longest) longest = probes;
+                    histogram[probes <= 4 ? probes - 1 : probes <= 8 ? 4 : probes <= 16 ? 5 : 6]++;
+                }
+                printf("%-8s %-11s %6.2f %6lld", functionNames[function], kind == 0 ? "bulunan" : "bulunamayan", (double)total / n, longest);
+                for (b = 0; b < 7; b++) printf(" %6.2f%%", 100.0 * histogram[b] / n);
+                printf("\n");
+            }
+            freeHashTable(&table);
+        }
+    }
+    free(names);
+}
+
+/*
+@brief Bu fonksiyon, N ismi once tek tek (insertName, searchName, deleteName), sonra toplu (insertBatch, searchBatch, deleteBatch) olarak isler ve hizlarini karsilastirir. Iki yol ayni boyutta iki tabloda calisir; sonuclari da karsilastirilir.
+@param n -> isim sayisi
+*/
+void benchmarkBatch(int n) {
+    static const char *stepNames[] = {"ekleme", "bulunan arama", "bulunamayan arama", "silme"};
+    int size = calculateTableSize(n, 0.75f);
+    char (*storage)[MAX_NAME_LENGTH] = malloc((size_t)2 * n * MAX_NAME_LENGTH);
+    char **names = (char **)malloc((size_t)2 * n * sizeof(char *));
+    int *single = (int *)malloc((size_t)n * sizeof(int));
+    int *batch = (int *)malloc((size_t)n * sizeof(int));
+    HashTable singleTable = createHashTable(size, 0.75f);
+    HashTable batchTable = createHashTable(size, 0.75f);
+    char mode[] = "NORMAL";
+    int step, i;
+
+    for (i = 0; i < 2 * n; i++) {
+        makeUserName(storage[i], (unsigned long long)i);
+        names[i] = storage[i];
+    }
+
+    printf("N: %d, tablo boyutu: %d, pencere: %d, deneme motoru: %s\n", n, size, BATCH_WINDOW, probeEngineName());
+    for (step = 0; step < 4; step++) {
+        char **stepNamesList = names + (step == 2 ? n : 0);
+        double start, singleTime, batchTime;
+        int mismatches = 0;
+
+        start = getTimeInSeconds();
+        for (i = 0; i < n; i++) {
+            switch (step) {
+                case 0: single[i] = insertName(&singleTable, stepNamesList[i], mode, n); break;
+                case 3: single[i] = deleteName(&singleTable, stepNamesList[i], mode); break;
+                default: single[i] = searchName(&singleTable, stepNamesList[i], mode);
+            }
+        }
+        singleTime = getTimeInSeconds() - start;
+
+        start = getTimeInSeconds();
+        switch (step) {
+            case 0: insertBatch(&batchTable, stepNamesList, n, n, batch); break;
+            case 3: deleteBatch(&batchTable, stepNamesList, n, batch); break;
+            default: searchBatch(&batchTable, stepNamesList, n, batch);
+        }
+        batchTime = getTimeInSeconds() - start;
+
+        for (i = 0; i < n; i++) {
+            mismatches += single[i] != batch[i];
+        }
+        printf("%-18s tek tek: %7.2f M islem/s  toplu: %7.2f M islem/s  hizlanma: %.2fx  farkli sonuc: %d\n",
+               stepNames[step], n / singleTime / 1e6, n / batchTime / 1e6, singleTime / batchTime, mismatches);
+    }
+
+    freeHashTable(&singleTable);
+    freeHashTable(&batchTable);
+    free(single);
+    free(batch);
+    free(names);
+    free(storage);
+}
+
+/*
+@brief Bu fonksiyon, N elemanli bir tabloda surekli silme ve ekleme yapar (her adimda rastgele bir aktif isim silinir ve hic gorulmemis bir isim eklenir, aktif eleman sayisi N'de kalir) ve belli araliklarla tablonun durumunu ve henuz eklenmemis isimlerle bulunamayan aramalarin ortalama deneme sayisini yazar. Bir aralik 5 saniyeden uzun surerse o ayarin olcumu durdurulur. Uc ayar karsilastirilir: sabit boyut ve temizlik yok, sadece buyume (silinmis slotlar da doluluga sayildigi icin buyume onlari da temizler) ve kademeli temizlik.
+@param n -> aktif eleman sayisi
+*/
+void benchmarkChurn(int n) {
+    static const char *variantNames[] = {"temizlik yok", "sadece buyume", "kademeli temizlik"};
+    int checkpoints = 8, stepOps = n / 2 > 0 ? n / 2 : 1, missSamples = 1000;
+    int nameCount = n + checkpoints * stepOps + missSamples;
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)nameCount * MAX_NAME_LENGTH);
+    int *live = (int *)malloc((size_t)n * sizeof(int));
+    char mode[] = "NORMAL";
+    uint64_t state;
+    int variant, checkpoint, i;
+
+    for (i = 0; i < nameCount; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+
+    printf("N: %d, baslangic boyutu: %d, load factor: 0.75, her aralikta %d silme + %d ekleme, deneme motoru: %s\n",
+           n, calculateTableSize(n, 0.75f), stepOps, stepOps, probeEngineName());
+    for (variant = 0; variant < 3; variant++) {
+        HashTable table = createHashTable(calculateTableSize(n, 0.75f), 0.75f);
+        int nextName = n;
+
+        table.autoResize = variant >= 1;
+        table.autoCompact = variant == 2;
+        state = 42;
+        for (i = 0; i < n; i++) {
+            insertName(&table, names[i], mode, n);
+            live[i] = i;
+        }
+
+        printf("\n%s\n%-8s %10s %8s %10s %10s %8s %12s %9s\n", variantNames[variant],
+               "islem", "M islem/s", "boyut", "silinmis", "ort.deneme", "en uzun", "bulunamayan", "temizlik");
+        for (checkpoint = 1; checkpoint <= checkpoints; checkpoint++) {
+            double start = getTimeInSeconds(), elapsed;
+            long long missProbes = 0;
+            TableStats stats;
+
+            for (i = 0; i < stepOps; i++) {
+                int slot = (int)(nextConcurrentRandom(&state) % (uint64_t)n);
+                deleteName(&table, names[live[slot]], mode);
+                live[slot] = nextName++;
+                insertName(&table, names[live[slot]], mode, n);
+            }
+            elapsed = getTimeInSeconds() - start;
+            stats = computeTableStats(&table);
+            activeProbeCount = &missProbes;
+            for (i = 0; i < missSamples; i++) {
+                findSlot(&table, names[nameCount - 1 - i], mode, computeSlotHash(names[nameCount - 1 - i], table.size));
+            }
+            activeProbeCount = NULL;
+            printf("%-8d %10.2f %8d %9.1f%% %10.2f %8lld %12.2f %9d\n", checkpoint * stepOps * 2,
+                   2.0 * stepOps / elapsed / 1e6, table.size, 100.0 * stats.tombstoneRatio,
+                   stats.meanProbe, stats.maxProbe, (double)missProbes / missSamples, stats.compactionCount);
+            if (elapsed > 5.0) {
+                printf("Aralik 5 saniyeden uzun surdu, bu ayarin olcumu durduruldu.\n");
                 break;
-            case 'q':
-                shouldExit = 1;
-                break;
-            default:
-                printf("Gecersiz islem. Lutfen gecerli bir komut girin.\n");
+            }
         }
+        freeHashTable(&table);
+    }
+    free(live);
+    free(names);
+}
+
+/*
+@brief Bu fonksiyon, filtrenin faydasini olcer. 0.5, 0.75, 0.9 ve 0.95 load factorlu sabit boyutlu tablolara N isim eklenir; sonra N tabloda olmayan isimle filtresiz ve filtreli bulunamayan arama, N tablodaki isimle bulunan arama yapilir. Yanlis pozitif orani, filtrenin tabloya gitmesine izin verdigi olmayan isimlerin oranidir. Ardindan isimlerin yarisi silinir (filtre silmelerle guncellenir); kalan isimlerin hepsinin filtreden gecmesi (yanlis negatif olmamasi) ve silmeden sonraki yanlis pozitif orani kontrol edilir.
+@param n -> isim sayisi
+*/
+void benchmarkFilter(int n) {
+    static const float loadFactors[] = {0.5f, 0.75f, 0.9f, 0.95f};
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)2 * n * MAX_NAME_LENGTH);
+    char mode[] = "NORMAL";
+    int lf, i;
+
+    for (i = 0; i < 2 * n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+
+    printf("N: %d, deneme motoru: %s, filtre: aktif isimlerin 2 kati kapasite, isim basina %d byte, her isim %d sayac artirir\n",
+           n, probeEngineName(), FILTER_COUNTERS_PER_NAME, FILTER_HASHES);
+    printf("%-6s %8s %12s %12s %12s %12s %12s %14s %10s\n", "lf", "yp %", "ort.deneme", "yok ns", "yok+f ns",
+           "var ns", "var+f ns", "silme sonra yp", "yanlis neg");
+    for (lf = 0; lf < 4; lf++) {
+        HashTable table = createHashTable(calculateTableSize(n, loadFactors[lf]), loadFactors[lf]);
+        double timings[4], start;
+        long long missProbes = 0;
+        int falsePositives = 0, falseNegatives = 0, afterDelete = 0, found = 0, pass;
+
+        table.autoResize = 0;
+        for (i = 0; i < n; i++) {
+            insertName(&table, names[i], mode, n);
+        }
+        activeProbeCount = &missProbes;
+        for (i = 0; i < n; i++) {
+            searchName(&table, names[n + i], mode);
+        }
+        activeProbeCount = NULL;
+
+        // 0: filtresiz bulunamayan, 1: filtreli bulunamayan, 2: filtresiz bulunan, 3: filtreli bulunan
+        for (pass = 0; pass < 4; pass++) {
+            if (pass == 1 || pass == 3) buildFilter(&table);
+            start = getTimeInSeconds();
+            for (i = 0; i < n; i++) {
+                found += searchName(&table, names[pass < 2 ? n + i : i], mode) >= 0;
+            }
+            timings[pass] = (getTimeInSeconds() - start) / n * 1e9;
+            if (pass == 1 || pass == 3) {
+                freeFilter(table.filter);
+                table.filter = NULL;
+            }
+        }
+
+        buildFilter(&table);
+        for (i = 0; i < n; i++) {
+            falsePositives += filterMayContain(table.filter, tableSlotHash(&table, names[n + i]).value);
+        }
+        for (i = 0; i < n; i += 2) {
+            deleteName(&table, names[i], mode);
+        }
+        for (i = 0; i < n; i++) {
+            int passes = filterMayContain(table.filter, tableSlotHash(&table, names[i]).value);
+            if (i % 2 == 1 && !passes) falseNegatives++;
+            afterDelete += filterMayContain(table.filter, tableSlotHash(&table, names[n + i]).value);
+        }
+        falseNegatives += found != 2 * n; // filtreli ve filtresiz bulunan aramalarin hepsi bulmus olmali
+
+        printf("%-6.2f %7.2f%% %12.2f %12.1f %12.1f %12.1f %12.1f %13.2f%% %10d\n", loadFactors[lf],
+               100.0 * falsePositives / n, (double)missProbes / n, timings[0], timings[1], timings[2], timings[3],
+               100.0 * afterDelete / n, falseNegatives);
+        freeHashTable(&table);
+    }
+    free(names);
+}
+
+/*
+@brief Bu fonksiyon, olcum icin istenen uzunlukta, i'ye gore tek bir isim uretir: i'nin 36'lik tabandaki yazilisi, bir nokta ve uzunluga tamamlayan harfler. Istenen uzunluk cok kisaysa isim sadece rakamlar ve noktadan olusur.
+@param buffer -> en az length + 1 byte'lik yer
+@param i -> ismin sirasi
+@param length -> istenen uzunluk
+*/
+static void makeNameOfLength(char *buffer, unsigned long long i, int length) {
+    unsigned long long mix = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    int count = 0, k;
+    char digits[16];
+
+    do {
+        digits[count++] = "0123456789abcdefghijklmnopqrstuvwxyz"[i % 36];
+        i /= 36;
+    } while (i > 0);
+    for (k = 0; k < count; k++) {
+        buffer[k] = digits[count - 1 - k];
+    }
+    buffer[count++] = '.';
+    while (count < length) {
+        buffer[count++] = (char)('a' + (mix >> 59) % 26);
+        mix = mix * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    buffer[count] = '\0';
+}
+
+/*
+@brief Bu fonksiyon, uc isim uzunlugu dagiliminda (kisa kullanici adlari, karisik gercekci adlar ve e-posta benzeri uzun adlar) tabloyu doldurur; sabit 30 byte'lik eski anahtar duzeninin ve NameRef + arena duzeninin eleman basina bellegini, 29 karakterden uzun olup eski duzende kesilecek isim sayisini ve bulunan ve bulunamayan aramalarin hizini yazar.
+@param n -> isim sayisi
+*/
+void benchmarkNames(int n) {
+    static const char *distributionNames[] = {"kisa (5-11)", "karisik (6-64)", "uzun (24-64)"};
+    int size = calculateTableSize(n, 0.75f);
+    char *storage = (char *)malloc((size_t)2 * n * 65);
+    char **names = (char **)malloc((size_t)2 * n * sizeof(char *));
+    char mode[] = "NORMAL";
+    int distribution, rounds = 5, round, i;
+
+    for (i = 0; i < 2 * n; i++) {
+        names[i] = storage + (size_t)i * 65;
+    }
+
+    printf("N: %d, tablo boyutu: %d, NameRef: %zu byte, kisa isim siniri: %d, deneme motoru: %s\n",
+           n, size, sizeof(NameRef), INLINE_NAME_LENGTH, probeEngineName());
+    printf("%-16s %8s %8s %9s %14s %14s %12s %14s\n", "dagilim", "ort.uzun", "kisa %", "kesilen",
+           "sabit byte/el.", "arena byte/el.", "bulunan M/s", "bulunamayan M/s");
+    for (distribution = 0; distribution < 3; distribution++) {
+        HashTable table = createHashTable(size, 0.75f);
+        uint64_t state = 7 + distribution;
+        long long totalLength = 0;
+        int inlineCount = 0, truncated = 0, found = 0;
+        double hitTime = 0, missTime = 0, start;
+
+        table.autoResize = 0;
+        for (i = 0; i < 2 * n; i++) {
+            uint64_t random = nextConcurrentRandom(&state);
+            int length;
+            if (distribution == 0) {
+                length = 5 + (int)(random % 7);
+            } else if (distribution == 1) {
+                int bucket = (int)(random % 100);
+                random >>= 8;
+                length = bucket < 70 ? 6 + (int)(random % 9) : bucket < 95 ? 15 + (int)(random % 16) : 31 + (int)(random % 34);
+            } else {
+                length = 24 + (int)(random % 41);
+            }
+            makeNameOfLength(names[i], (unsigned long long)i, length);
+            if (i < n) {
+                length = (int)strlen(names[i]);
+                totalLength += length;
+                inlineCount += length <= INLINE_NAME_LENGTH;
+                truncated += length >= MAX_NAME_LENGTH;
+            }
+        }
+        for (i = 0; i < n; i++) {
+            insertName(&table, names[i], mode, n);
+        }
+
+        for (round = 0; round < rounds; round++) {
+            start = getTimeInSeconds();
+            for (i = 0; i < n; i++) {
+                found += searchName(&table, names[i], mode) >= 0;
+            }
+            hitTime += getTimeInSeconds() - start;
+            start = getTimeInSeconds();
+            for (i = n; i < 2 * n; i++) {
+                found += searchName(&table, names[i], mode) >= 0;
+            }
+            missTime += getTimeInSeconds() - start;
+        }
+
+        printf("%-16s %8.1f %7.1f%% %9d %14.1f %14.1f %12.2f %14.2f%s\n", distributionNames[distribution],
+               (double)totalLength / n, 100.0 * inlineCount / n, truncated,
+               (double)size * (1 + MAX_NAME_LENGTH) / n,
+               ((double)size * (1 + sizeof(NameRef)) + (double)table.arena->capacity) / n,
+               (double)n * rounds / hitTime / 1e6, (double)n * rounds / missTime / 1e6,
+               found == n * rounds ? "" : "  (HATA: bulunan sayisi yanlis)");
+        freeHashTable(&table);
+    }
+    free(names);
+    free(storage);
+}
+
+/*
+@brief Bu fonksiyon, bir tampondaki byte'larin hepsini dosyaya yazar; write kismi yazim yapabildigi icin dongu kullanilir.
+@param fd -> dosya
+@param buffer -> yazilacak byte'lar
+@param length -> byte sayisi
+@return basarili ise 0, hata olursa -1
+*/
+static int writeAll(int fd, const void *buffer, size_t length) {
+    const char *bytes = (const char *)buffer;
+
+    while (length > 0) {
+        ssize_t written = write(fd, bytes, length);
+        if (written < 0) return -1;
+        bytes += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+/*
+@brief Bu fonksiyon, bir dosya bolumunun sonunu SNAPSHOT_ALIGN'a kadar sifirla doldurur.
+@param fd -> dosya
+@param offset -> bolumun bittigi yer, hizalanmis yer buraya yazilir
+@return basarili ise 0, hata olursa -1
+*/
+static int padSnapshot(int fd, uint64_t *offset) {
+    static const char zeros[SNAPSHOT_ALIGN];
+    size_t padding = (size_t)((SNAPSHOT_ALIGN - *offset % SNAPSHOT_ALIGN) % SNAPSHOT_ALIGN);
+
+    *offset += padding;
+    return writeAll(fd, zeros, padding);
+}
+
+/*
+@brief Bu fonksiyon, tabloyu bir kayit dosyasina yazar: baslik, kontrol dizisi (grup motorunun ayna byte'lariyla), NameRef dizisi ve arenanin kullanilan kismi. Devam eden bir buyume once bitirilir. Dosya once ayni dizinde gecici bir isimle yazilir ve fsync edilir, sonra rename ile yerine konur; boylece yarim kalan bir kayit eski dosyayi bozmaz.
+@param table -> kaydedilecek hash tablosu
+@param path -> dosya adi
+@return basarili ise 0, hata olursa -1
+*/
+int writeSnapshot(HashTable *table, const char *path) {
+    SnapshotHeader header;
+    size_t pathLength = strlen(path);
+    char *temporaryPath = (char *)malloc(pathLength + 16);
+    char *directory;
+    uint64_t offset;
+    int fd, directoryFd;
+
+    finishMigration(table);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.engine = PROBE_STRATEGY_ID;
+    header.nameRefSize = sizeof(NameRef);
+    header.size = table->size;
+    header.elementCount = table->elementCount;
+    header.deletedCount = table->deletedCount;
+    header.compactionCount = table->compactionCount;
+    header.loadFactor = table->loadFactor;
+    offset = (sizeof(SnapshotHeader) + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+    header.controlOffset = offset;
+    header.controlLength = (uint64_t)table->size + GROUP_SIZE - 1;
+    offset += (header.controlLength + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+    header.namesOffset = offset;
+    offset += ((uint64_t)table->size * sizeof(NameRef) + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+    header.arenaOffset = offset;
+    header.arenaLength = table->arena->used;
+    header.arenaDeadBytes = table->arena->deadBytes;
+    header.fileLength = offset + header.arenaLength;
+
+    snprintf(temporaryPath, pathLength + 16, "%s.tmpXXXXXX", path);
+    fd = mkstemp(temporaryPath);
+    if (fd < 0) {
+        fprintf(stderr, "%s: gecici kayit dosyasi acilamadi\n", temporaryPath);
+        free(temporaryPath);
+        return -1;
+    }
+
+    offset = sizeof(header);
+    if (writeAll(fd, &header, sizeof(header)) != 0 || padSnapshot(fd, &offset) != 0 ||
+        writeAll(fd, table->control, header.controlLength) != 0 ||
+        (offset += header.controlLength, padSnapshot(fd, &offset)) != 0 ||
+        writeAll(fd, table->names, (size_t)table->size * sizeof(NameRef)) != 0 ||
+        (offset += (uint64_t)table->size * sizeof(NameRef), padSnapshot(fd, &offset)) != 0 ||
+        writeAll(fd, table->arena->bytes, header.arenaLength) != 0 ||
+        fchmod(fd, 0644) != 0 || fsync(fd) != 0) {
+        fprintf(stderr, "%s: kayit dosyasi yazilamadi\n", temporaryPath);
+        close(fd);
+        unlink(temporaryPath);
+        free(temporaryPath);
+        return -1;
+    }
+    close(fd);
+
+    if (rename(temporaryPath, path) != 0) {
+        fprintf(stderr, "%s: kayit dosyasi yerine konamadi\n", path);
+        unlink(temporaryPath);
+        free(temporaryPath);
+        return -1;
+    }
+
+    // rename'in kendisinin de diske yazilmasi icin dosyanin bulundugu dizin fsync edilir
+    directory = temporaryPath;
+    strcpy(directory, path);
+    if (strrchr(directory, '/') != NULL) {
+        *strrchr(directory, '/') = '\0';
+        if (directory[0] == '\0') strcpy(directory, "/");
+    } else {
+        strcpy(directory, ".");
+    }
+    directoryFd = open(directory, O_RDONLY);
+    if (directoryFd >= 0) {
+        fsync(directoryFd);
+        close(directoryFd);
+    }
+    free(temporaryPath);
+    return 0;
+}
+
+/*
+@brief Bu fonksiyon, writeSnapshot ile yazilmis bir kayit dosyasini mmap ile acar. Tablonun kontrol dizisi, NameRef dizisi ve arenasi dogrudan eslenen bellegi gosterir, hicbir eleman kopyalanmaz ya da yeniden eklenmez. Baslik; surum, byte sirasi, deneme motoru, NameRef boyutu ve bolumlerin dosyaya sigmasi icin kontrol edilir.
+@param path -> dosya adi
+@param openMode -> SNAPSHOT_READ_ONLY ise tablo salt okunurdur; SNAPSHOT_COPY_ON_WRITE ise tablo degistirilebilir, degisen sayfalar sadece bu surecin kopyasina yazilir ve dosya degismez
+@param table -> acilan tablo buraya yazilir, freeHashTable ile birakilir
+@return basarili ise 0, hata olursa -1
+*/
+int openSnapshot(const char *path, int openMode, HashTable *table) {
+    struct stat fileStat;
+    SnapshotHeader header;
+    unsigned char *mapping;
+    int fd = open(path, O_RDONLY);
+    int protection = openMode == SNAPSHOT_COPY_ON_WRITE ? PROT_READ | PROT_WRITE : PROT_READ;
+    uint32_t engine = PROBE_STRATEGY_ID;
+
+    if (fd < 0) {
+        fprintf(stderr, "%s: kayit dosyasi acilamadi\n", path);
+        return -1;
     }
+    if (fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(SnapshotHeader)) {
+        fprintf(stderr, "%s: kayit dosyasi cok kisa\n", path);
+        close(fd);
+        return -1;
+    }
+    mapping = (unsigned char *)mmap(NULL, (size_t)fileStat.st_size, protection, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "%s: kayit dosyasi eslenemedi\n", path);
+        return -1;
+    }
+
+    memcpy(&header, mapping, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.version != SNAPSHOT_VERSION ||
+        header.byteOrder != SNAPSHOT_BYTE_ORDER) {
+        fprintf(stderr, "%s: kayit dosyasi degil ya da surumu/byte sirasi farkli\n", path);
+    } else if (header.engine != engine || header.nameRefSize != sizeof(NameRef)) {
+        fprintf(stderr, "%s: kayit farkli bir deneme motoru ya da isim duzeniyle yazilmis\n", path);
+    } else if (header.size < MIN_TABLE_SIZE || header.fileLength != (uint64_t)fileStat.st_size ||
+               header.controlLength != (uint64_t)header.size + GROUP_SIZE - 1 ||
+               header.controlOffset + header.controlLength > header.namesOffset ||
+               header.namesOffset + (uint64_t)header.size * sizeof(NameRef) > header.arenaOffset ||
+               header.arenaOffset + header.arenaLength != header.fileLength ||
+               header.elementCount < header.deletedCount || header.elementCount > header.size ||
+               header.controlOffset % SNAPSHOT_ALIGN != 0 || header.namesOffset % SNAPSHOT_ALIGN != 0) {
+        fprintf(stderr, "%s: kayit dosyasi bozuk\n", path);
+    } else {
+        *table = createHashTable(MIN_TABLE_SIZE, header.loadFactor);
+        free(table->control);
+        free(table->names);
+        table->control = mapping + header.controlOffset;
+        table->names = (NameRef *)(mapping + header.namesOffset);
+        table->size = header.size;
+        table->elementCount = header.elementCount;
+        table->deletedCount = header.deletedCount;
+        table->compactionCount = header.compactionCount;
+        table->mapped = 1;
+        table->readOnly = openMode != SNAPSHOT_COPY_ON_WRITE;
+        table->arena->bytes = (char *)mapping + header.arenaOffset;
+        table->arena->used = header.arenaLength;
+        table->arena->capacity = header.arenaLength;
+        table->arena->deadBytes = header.arenaDeadBytes;
+        table->arena->mappedBytes = 1;
+        table->arena->mapping = mapping;
+        table->arena->mappingLength = (size_t)fileStat.st_size;
+        return 0;
+    }
+    munmap(mapping, (size_t)fileStat.st_size);
+    return -1;
+}
+
+/*
+@brief Bu fonksiyon, N isimlik bir tabloyu baslangicta hazir hale getirmenin iki yolunu karsilastirir: isimleri bastan eklemek (kucuk tablodan buyuyerek ve bastan dogru boyutla) ve kayit dosyasini mmap ile acmak. Dosya acilmadan once sayfa onbellegi bosaltilir, ilk arama diskten okur. Ayrica kayit yazma suresi, dosya boyutu, N aramanin suresi ve --cow ile acilan tabloya ekleme yapildiginda dosyanin degismedigi yazilir. Isimlerin uzunlugu 6 ile 25 arasinda degisir, uzun isimler arenaya yazilir.
+@param n -> isim sayisi
+@param path -> kayit dosyasinin adi, olcumden sonra silinmez
+*/
+void benchmarkSnapshot(int n, const char *path) {
+    char mode[] = "NORMAL";
+    char userName[MAX_INPUT_LENGTH];
+    HashTable table, opened;
+    struct stat fileStat;
+    double start, rebuildTime, presizedTime, writeTime, openTime, firstTime, searchTime;
+    int i, found = 0, cowExtra = n / 100 > 0 ? n / 100 : 1, fd;
+
+#define SNAPSHOT_NAME(i) makeNameOfLength(userName, (unsigned long long)(i), 6 + (int)(((unsigned long long)(i) * 0x9E3779B97F4A7C15ULL) >> 59) % 20)
+
+    printf("N: %d, load factor: 0.75, deneme motoru: %s, dosya: %s\n", n, probeEngineName(), path);
 
+    table = createHashTable(calculateTableSize(n, 0.75f), 0.75f);
+    start = getTimeInSeconds();
+    for (i = 0; i < n; i++) {
+        SNAPSHOT_NAME(i);
+        insertName(&table, userName, mode, n);
+    }
+    presizedTime = getTimeInSeconds() - start;
+    freeHashTable(&table);
+
+    table = createHashTable(11, 0.75f);
+    start = getTimeInSeconds();
+    for (i = 0; i < n; i++) {
+        SNAPSHOT_NAME(i);
+        insertName(&table, userName, mode, n);
+    }
+    finishMigration(&table);
+    rebuildTime = getTimeInSeconds() - start;
 
+    start = getTimeInSeconds();
+    if (writeSnapshot(&table, path) != 0) {
+        freeHashTable(&table);
+        return;
+    }
+    writeTime = getTimeInSeconds() - start;
     freeHashTable(&table);
+    stat(path, &fileStat);
+
+    // dosyanin sayfa onbellegindeki kopyasi atilir ki mmap acilisi soguk olculsun
+    fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+
+    start = getTimeInSeconds();
+    if (openSnapshot(path, SNAPSHOT_READ_ONLY, &opened) != 0) return;
+    openTime = getTimeInSeconds() - start;
+    SNAPSHOT_NAME(0);
+    start = getTimeInSeconds();
+    found += searchName(&opened, userName, mode) >= 0;
+    firstTime = getTimeInSeconds() - start;
+    start = getTimeInSeconds();
+    for (i = 1; i < n; i++) {
+        SNAPSHOT_NAME(i);
+        found += searchName(&opened, userName, mode) >= 0;
+    }
+    searchTime = getTimeInSeconds() - start;
+    freeHashTable(&opened);
+
+    printf("%-34s %10.3f s\n", "bastan kurma (11'den buyuyerek)", rebuildTime);
+    printf("%-34s %10.3f s\n", "bastan kurma (dogru boyutla)", presizedTime);
+    printf("%-34s %10.3f s  (%.1f MB)\n", "kayit yazma (fsync + rename)", writeTime, fileStat.st_size / 1e6);
+    printf("%-34s %10.6f s\n", "mmap ile acma (salt okunur)", openTime);
+    printf("%-34s %10.6f s\n", "ilk arama (soguk sayfa)", firstTime);
+    printf("%-34s %10.3f s  (bulunan: %d/%d)\n", "acilan tabloda N arama", searchTime, found, n);
+
+    // --cow: eklemeler surecin kopyasina yazilir, dosya ayni kalir
+    if (openSnapshot(path, SNAPSHOT_COPY_ON_WRITE, &opened) != 0) return;
+    found = 0;
+    start = getTimeInSeconds();
+    for (i = n; i < n + cowExtra; i++) {
+        SNAPSHOT_NAME(i);
+        found += insertName(&opened, userName, mode, INT_MAX) >= 0;
+    }
+    printf("%-34s %10.3f s  (eklenen: %d/%d)\n", "--cow acilan tabloya ekleme", getTimeInSeconds() - start, found, cowExtra);
+    freeHashTable(&opened);
+
+    if (openSnapshot(path, SNAPSHOT_READ_ONLY, &opened) != 0) return;
+    found = 0;
+    for (i = n; i < n + cowExtra; i++) {
+        SNAPSHOT_NAME(i);
+        found += searchName(&opened, userName, mode) >= 0;
+    }
+    printf("%-34s %10s    (dosyada bulunan yeni isim: %d)\n", "dosya degismedi mi", found == 0 ? "evet" : "HAYIR", found);
+    freeHashTable(&opened);
+#undef SNAPSHOT_NAME
+}
+
+/*
+@brief Bu fonksiyon, bir dosyanin ya da "-" verilirse standart girisin tamamini bellege okur ve sonuna '\0' koyar.
+@param path -> dosya adi ya da "-"
+@param length -> okunan byte sayisi buraya yazilir
+@return okunan tampon (free ile birakilir) ya da hata olursa NULL
+*/
+static char *readWholeInput(const char *path, size_t *length) {
+    FILE *file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    size_t capacity = 1 << 20, used = 0, count;
+    char *buffer;
+
+    if (file == NULL) {
+        fprintf(stderr, "%s: komut dosyasi acilamadi\n", path);
+        return NULL;
+    }
+    buffer = (char *)malloc(capacity);
+    while ((count = fread(buffer + used, 1, capacity - used - 1, file)) > 0) {
+        used += count;
+        if (capacity - used - 1 == 0) {
+            capacity *= 2;
+            buffer = (char *)realloc(buffer, capacity);
+        }
+    }
+    if (file != stdin) fclose(file);
+    buffer[used] = '\0';
+    *length = used;
+    return buffer;
+}
+
+/*
+@brief Bu fonksiyon, komut akisini yerinde ayristirir. Her satir bir islem ve bir isimden olusur: "insert", "ekle" ya da "e" ekleme; "delete", "sil" ya da "s" silme; "search", "ara" ya da "a" aramadir (tek harfler menudeki harflerdir). Bos satirlar ve '#' ile baslayan satirlar atlanir. Isimlerin sonuna tamponda '\0' yazilir, isimler kopyalanmaz.
+@param buffer -> '\0' ile biten komut metni, degistirilir
+@param path -> hata mesajlari icin dosya adi
+@param count -> okunan komut sayisi buraya yazilir
+@return komut dizisi (free ile birakilir) ya da hatali bir satir varsa NULL
+*/
+static ReplayCommand *parseCommands(char *buffer, const char *path, int *count) {
+    int capacity = 1024, used = 0, line = 1;
+    ReplayCommand *commands = (ReplayCommand *)malloc((size_t)capacity * sizeof(ReplayCommand));
+    char *p = buffer;
+
+    while (*p != '\0') {
+        char *word, *name;
+        size_t wordLength;
+        int commandLine;
+
+        while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+        if (*p == '\n') {
+            p++;
+            line++;
+            continue;
+        }
+        if (*p == '\0') break;
+        if (*p == '#') {
+            while (*p != '\n' && *p != '\0') p++;
+            continue;
+        }
+
+        word = p;
+        commandLine = line;
+        while (*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' && *p != '\0') p++;
+        wordLength = (size_t)(p - word);
+        while (*p == ' ' || *p == '\t') p++;
+        name = p;
+        while (*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' && *p != '\0') p++;
+        if (p == name) {
+            fprintf(stderr, "%s:%d: isim eksik\n", path, line);
+            free(commands);
+            return NULL;
+        }
+        if (*p != '\0') {
+            // ismin sonu '\0' yapilir; satirin geri kalani sadece bosluk olabilir
+            char *end = p;
+            while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+            if (*p != '\n' && *p != '\0') {
+                fprintf(stderr, "%s:%d: satirda fazladan kelime var\n", path, line);
+                free(commands);
+                return NULL;
+            }
+            if (*p == '\n') {
+                p++;
+                line++;
+            }
+            *end = '\0';
+        }
+
+        if (used == capacity) {
+            capacity *= 2;
+            commands = (ReplayCommand *)realloc(commands, (size_t)capacity * sizeof(ReplayCommand));
+        }
+        if ((wordLength == 1 && word[0] == 'e') || (wordLength == 4 && strncmp(word, "ekle", 4) == 0) ||
+            (wordLength == 6 && strncmp(word, "insert", 6) == 0)) {
+            commands[used].operation = BATCH_INSERT;
+        } else if ((wordLength == 1 && word[0] == 's') || (wordLength == 3 && strncmp(word, "sil", 3) == 0) ||
+                   (wordLength == 6 && strncmp(word, "delete", 6) == 0)) {
+            commands[used].operation = BATCH_DELETE;
+        } else if ((wordLength == 1 && word[0] == 'a') || (wordLength == 3 && strncmp(word, "ara", 3) == 0) ||
+                   (wordLength == 6 && strncmp(word, "search", 6) == 0)) {
+            commands[used].operation = BATCH_SEARCH;
+        } else {
+            fprintf(stderr, "%s:%d: bilinmeyen islem '%.*s'\n", path, commandLine, (int)wordLength, word);
+            free(commands);
+            return NULL;
+        }
+        commands[used].name = name;
+        used++;
+    }
+    *count = used;
+    return commands;
+}
+
+/*
+@brief qsort icin iki gecikme degerini karsilastirir.
+*/
+static int compareLatency(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+@brief Bu fonksiyon, komut akisindaki islemleri tabloya uygular (yavas yavas buyuyen, 11 boyutlu bos bir tablodan baslanir, N siniri yoktur) ve olcumleri yazar. Akis iki kez calistirilir: ilk calismada sadece toplam sure olculur ve islem hizi bundan hesaplanir; ikinci calismada yeni bir tabloda her islemin suresi ve deneme sayisi (grup motorunda grup sayisi, tasinan elemanlarin denemeleri dahil) kaydedilir, gecikme yuzdelikleri ve deneme sayisi dagilimi bundan hesaplanir. Boylece saat okumalari islem hizini bozmaz. DEBUG modunda islemlerin ciktisi da yazilir, olcumler anlamini yitirir.
+@param path -> komut dosyasi ya da standart giris icin "-"
+@param mode -> NORMAL ya da DEBUG, butun calisma icin bir kez verilir
+@return basarili ise 0, dosya okunamazsa ya da hataliysa 1
+*/
+int replayCommands(const char *path, char *mode) {
+    static const char *operationNames[3] = {"ekleme", "arama", "silme"};
+    static const double percentiles[4] = {0.50, 0.90, 0.99, 0.999};
+    size_t length;
+    double start, parseTime, runTime = 0;
+    char *buffer;
+    ReplayCommand *commands;
+    uint32_t *latencies[3];
+    long long probeHistogram[3][PROBE_BUCKETS];
+    int counts[3] = {0, 0, 0}, successes[3] = {0, 0, 0}, timedSuccesses = 0, filled[3] = {0, 0, 0};
+    int count, i, operation, k, pass;
+
+    start = getTimeInSeconds();
+    buffer = readWholeInput(path, &length);
+    if (buffer == NULL) return 1;
+    commands = parseCommands(buffer, path, &count);
+    if (commands == NULL) {
+        free(buffer);
+        return 1;
+    }
+    parseTime = getTimeInSeconds() - start;
+
+    for (i = 0; i < count; i++) {
+        counts[commands[i].operation]++;
+    }
+    for (operation = 0; operation < 3; operation++) {
+        latencies[operation] = (uint32_t *)malloc(((size_t)counts[operation] + 1) * sizeof(uint32_t));
+        memset(probeHistogram[operation], 0, sizeof(probeHistogram[operation]));
+    }
+
+    for (pass = 0; pass < 2; pass++) {
+        HashTable table = createHashTable(11, 0.75f);
+
+        start = getTimeInSeconds();
+        for (i = 0; i < count; i++) {
+            ReplayCommand *command = &commands[i];
+            struct timespec before, after;
+            long long probes = 0;
+            int result;
+
+            if (pass == 1) {
+                activeProbeCount = &probes;
+                clock_gettime(CLOCK_MONOTONIC, &before);
+            }
+            switch (command->operation) {
+                case BATCH_INSERT:
+                    result = insertName(&table, command->name, mode, INT_MAX);
+                    break;
+                case BATCH_SEARCH:
+                    result = searchName(&table, command->name, mode);
+                    break;
+                default:
+                    result = deleteName(&table, command->name, mode);
+            }
+            if (pass == 0) {
+                successes[command->operation] += result >= 0;
+            } else {
+                clock_gettime(CLOCK_MONOTONIC, &after);
+                activeProbeCount = NULL;
+                timedSuccesses += result >= 0;
+                latencies[command->operation][filled[command->operation]++] =
+                    (uint32_t)((after.tv_sec - before.tv_sec) * 1000000000LL + (after.tv_nsec - before.tv_nsec));
+                probeHistogram[command->operation][probes < PROBE_BUCKETS ? (probes > 0 ? probes - 1 : 0) : PROBE_BUCKETS - 1]++;
+            }
+        }
+        if (pass == 0) runTime = getTimeInSeconds() - start;
+        if (pass == 1 && DEBUG_MODE(mode) == 0) {
+            TableStats stats = computeTableStats(&table); // buyume surerken eski tabloda bekleyen elemanlar da sayilir
+            printf("Komut: %d (%.1f MB, okuma ve ayristirma %.3f s), son tablo boyutu: %d, aktif eleman: %d, deneme motoru: %s\n",
+                   count, length / 1e6, parseTime, table.size, stats.liveCount + stats.pendingCount, probeEngineName());
+        }
+        freeHashTable(&table);
+    }
+
+    printf("%-8s %10s %10s %8s %8s %8s %8s %10s\n", "islem", "sayi", "basarili",
+           "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "en uzun ns");
+    for (operation = 0; operation < 3; operation++) {
+        uint32_t *sorted = latencies[operation];
+        int total = counts[operation];
+
+        if (total == 0) continue;
+        qsort(sorted, (size_t)total, sizeof(uint32_t), compareLatency);
+        printf("%-8s %10d %10d", operationNames[operation], total, successes[operation]);
+        for (k = 0; k < 4; k++) {
+            printf(" %8u", sorted[(int)(percentiles[k] * (total - 1))]);
+        }
+        printf(" %10u\n", sorted[total - 1]);
+    }
+    printf("%-8s %10d %10d   (%.3f s, %.2f M islem/s)\n", "toplam", count, successes[0] + successes[1] + successes[2],
+           runTime, runTime > 0 ? count / runTime / 1e6 : 0.0);
+    if (timedSuccesses != successes[0] + successes[1] + successes[2]) {
+        printf("HATA: iki calismada basarili islem sayisi farkli (%d)\n", timedSuccesses);
+    }
+
+    printf("\nDeneme sayisi dagilimi (%s):\n%-8s", probeEngineName(), "deneme");
+    for (operation = 0; operation < 3; operation++) printf(" %10s", operationNames[operation]);
+    printf("\n");
+    for (k = 0; k < PROBE_BUCKETS; k++) {
+        if (probeHistogram[0][k] + probeHistogram[1][k] + probeHistogram[2][k] == 0) continue;
+        if (k == PROBE_BUCKETS - 1) printf(">%-7d", PROBE_BUCKETS - 1);
+        else printf("%-8d", k + 1);
+        for (operation = 0; operation < 3; operation++) {
+            printf(" %9.2f%%", counts[operation] ? 100.0 * probeHistogram[operation][k] / counts[operation] : 0.0);
+        }
+        printf("\n");
+    }
+
+    for (operation = 0; operation < 3; operation++) free(latencies[operation]);
+    free(commands);
+    free(buffer);
     return 0;
 }
+
+/*
+@brief Bu fonksiyon, --replay icin ornek bir komut akisi uretir ve standart cikisa yazar: N isimlik bir anahtar uzayindan rastgele secilen isimlerle N/2 ekleme ile baslar, sonra 2N karisik islem gelir (%50 arama, %30 ekleme, %20 silme).
+@param n -> anahtar uzayi
+*/
+void generateCommandLog(int n) {
+    static char outputBuffer[1 << 16];
+    char userName[MAX_NAME_LENGTH];
+    uint64_t state = 17;
+    int i;
+
+    setvbuf(stdout, outputBuffer, _IOFBF, sizeof(outputBuffer));
+    printf("# HW3 komut akisi, anahtar uzayi %d\n", n);
+    for (i = 0; i < n / 2; i++) {
+        makeUserName(userName, nextConcurrentRandom(&state) % (uint64_t)n);
+        printf("insert %s\n", userName);
+    }
+    for (i = 0; i < 2 * n; i++) {
+        uint64_t random = nextConcurrentRandom(&state);
+        int percent = (int)(random % 100);
+        makeUserName(userName, (random >> 8) % (uint64_t)n);
+        printf("%s %s\n", percent < 50 ? "search" : percent < 80 ? "insert" : "delete", userName);
+    }
+    fflush(stdout);
+}
+
+/*
+@brief Bu fonksiyon, derlenen cakisma cozme stratejisini 0.5 ile 0.95 arasindaki load factor'lerde olcer. Her load factor icin N isim sigacak boyutta buyumeyen bir tablo acilir ve N isim eklenir; sonra bulunan ve bulunamayan N arama ve N/2 silme + N/2 yeni ekleme yapilir. Her biri icin islem hizi, eleman basina bellek (kontrol ve NameRef dizisi ile arena) ve bulunan ve bulunamayan aramalardaki ortalama ve en uzun deneme sayisi yazilir. Stratejiler derlemede secildigi icin her strateji ayri derlenip calistirilir (README'deki dongu).
+@param n -> isim sayisi
+*/
+void benchmarkStrategy(int n) {
+    static const float loadFactors[6] = {0.5f, 0.6f, 0.7f, 0.8f, 0.9f, 0.95f};
+    char (*names)[MAX_NAME_LENGTH] = malloc((size_t)(3 * n) * MAX_NAME_LENGTH);
+    char mode[] = "NORMAL";
+    int i, f;
+
+    for (i = 0; i < 3 * n; i++) {
+        makeUserName(names[i], (unsigned long long)i);
+    }
+
+    printf("N: %d, strateji: %s\n", n, probeEngineName());
+    printf("%5s %8s %12s %12s %12s %12s %8s %10s %8s %10s %10s\n", "lf", "boyut", "ekleme M/s", "bulunan M/s",
+           "bulunmyn M/s", "sil+ekle M/s", "byte/el", "ort. den.", "en uzun", "bulunmyn", "eklenemedi");
+    for (f = 0; f < 6; f++) {
+        int size = calculateTableSize(n, loadFactors[f]);
+        HashTable table = createHashTable(size, loadFactors[f]);
+        double start, insertTime, hitTime, missTime, churnTime;
+        long long missProbes = 0;
+        int failed = 0, found = 0;
+        TableStats stats;
+
+        table.autoResize = 0;
+        start = getTimeInSeconds();
+        for (i = 0; i < n; i++) {
+            failed += insertName(&table, names[i], mode, INT_MAX) < 0;
+        }
+        insertTime = getTimeInSeconds() - start;
+
+        start = getTimeInSeconds();
+        for (i = 0; i < n; i++) {
+            found += searchName(&table, names[i], mode) >= 0;
+        }
+        hitTime = getTimeInSeconds() - start;
+        start = getTimeInSeconds();
+        for (i = n; i < 2 * n; i++) {
+            found += searchName(&table, names[i], mode) >= 0;
+        }
+        missTime = getTimeInSeconds() - start;
+
+        stats = computeTableStats(&table);
+        activeProbeCount = &missProbes;
+        for (i = n; i < 2 * n; i++) {
+            searchName(&table, names[i], mode);
+        }
+        activeProbeCount = NULL;
+
+        start = getTimeInSeconds();
+        for (i = 0; i < n / 2; i++) {
+            deleteName(&table, names[2 * i], mode);
+            insertName(&table, names[2 * n + i], mode, INT_MAX);
+        }
+        churnTime = getTimeInSeconds() - start;
+
+        printf("%5.2f %8d %12.2f %12.2f %12.2f %12.2f %8.1f %10.2f %8lld %10.2f %10d%s\n", loadFactors[f], size,
+               n / insertTime / 1e6, n / hitTime / 1e6, n / missTime / 1e6, n / churnTime / 1e6,
+               ((double)table.size * (1 + sizeof(NameRef)) + GROUP_SIZE - 1 + (double)table.arena->capacity) / n,
+               stats.meanProbe, stats.maxProbe, (double)missProbes / n, failed,
+               found == n - failed ? "" : "  (HATA: bulunan sayisi yanlis)");
+        freeHashTable(&table);
+    }
+    free(names);
+}
@@ -14,32 +14,143 @@
     At the end of the program, it displays the length of LCS and all LCSs found.
     This program includes these functions which are explained in detail in their own sections:
         - A function to print a matrix
-        - A recursive function to find and print all LCS
+        - A function to list every distinct LCS once
         - A function to calculate LCS length and fill DP and choice matrices
         - A function to get user's choicae for displaying matrices
         - A main function to find and print all LCS 
+
+    The strings can be of any length. They are read into heap buffers and the matrices are allocated on the heap
+    for the exact string lengths. When the two full matrices would need more than FULL_MATRIX_LIMIT cells, the
+    program does not build them; it finds one LCS with Hirschberg's algorithm instead, which keeps only a few rows
+    of the DP (O(m + n) memory) and splits the problem in two at the row in the middle.
+
+    Command line:
+        - no arguments                   -> interactive mode
+        - --lcs <file1> <file2>          -> prints the LCS length and one LCS of the contents of two files
+        - --bench-hirschberg <N>         -> runs Hirschberg on random DNA-like strings of length 1000, 10000, ... up
+                                            to N and reports the runtime and the peak memory
+        - --lcs-length <file1> <file2>   -> prints only the LCS length, computed bit-parallel
+        - --all-lcs <file1> <file2> [limit]
+                                         -> prints every distinct LCS of the two files once, at most limit of them
+        - --count-lcs <file1> <file2> [exact]
+                                         -> prints the number of distinct LCS of the two files, 64-bit or exact
+        - --bench-bitparallel <N>        -> checks the bit-parallel kernels against lcs and compares their speed with
+                                            the cell-by-cell DP up to length N
+        - --bench-wavefront <N> [tile] [threads]
+                                         -> checks the wavefront fill against lcs and times it on two random strings
+                                            of length N with 1, 2, 4, ... up to the given number of threads (32 by
+                                            default)
+
+    When only the length is needed, lcsLengthBitParallel computes it bit-parallel (Allison-Dix / Hyyro): one bit per
+    character of the shorter string, so a 64-bit word operation updates 64 DP cells. The match masks of the
+    characters are precomputed, a row of the DP is a few word operations per 64 cells and the rows carry from word
+    to word. On CPUs with AVX2 (checked at runtime) four words are updated at once, 256 cells per vector step, and
+    the carries between the lanes are resolved like in a carry-lookahead adder.
+
+    When the full matrices are needed (for enumerateLCS or to print them), lcsWavefront fills them with several
+    threads. The matrix is cut into tileSize x tileSize tiles. A tile only needs the tiles above it, to its left and
+    above-left, so all the tiles on one anti-diagonal of tiles can be filled at the same time. The threads take the
+    tiles of the current anti-diagonal one by one and wait for each other at a barrier before the next one. The
+    matrices are exactly the ones lcs fills.
+
+    enumerateLCS lists the LCS strings from the DP matrix. The same LCS can be formed by many different pairs of
+    positions, so it does not follow positions: it follows characters. From a cell it tries each character at its
+    last occurrence in the two prefixes, so every distinct LCS is reached by exactly one path and reported once, and
+    no path is a dead end. The strings are given to a callback, which can stop the enumeration, and printAllLCS
+    writes them through an output buffer. Before listing, printAllLCS prints how many there are: countLCS and
+    countLCSExact count the paths of the same DAG level by level, in 64 bits or with arbitrary precision, without
+    building a single string.
 */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#define MAX 100
+#include <time.h>
+#include <stdint.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAVE_AVX2_KERNEL 1
+#endif
+
+#define FULL_MATRIX_LIMIT 25000000LL // above this many cells per matrix the interactive mode uses Hirschberg
+#define WAVEFRONT_TILE 512 // default tile side of lcsWavefront, below 256 the short row pieces of a tile were measured to be slower
+#define WAVEFRONT_MIN_CELLS 1000000LL // below this many cells starting the threads costs more than it saves
+#define OUTPUT_BUFFER_SIZE 65536 // bytes of LCS output collected before one fwrite
+
+// a bit-parallel LCS kernel: updates the pattern bit vector V for every character of the text
+typedef void (*LcsKernel)(const uint64_t *masks, int words, const unsigned char *text, int textLength, uint64_t *V);
+
+// called by enumerateLCS for every distinct LCS, a nonzero return value stops the enumeration
+typedef int (*LcsCallback)(const char *lcs, int length, void *context);
+
+// the LCS strings are copied here and written to the stream when the buffer is full
+typedef struct {
+    FILE *stream;
+    size_t used;
+    char data[OUTPUT_BUFFER_SIZE];
+} OutputBuffer;
+
+// an edge of the LCS DAG between two levels, used to count the paths
+typedef struct {
+    long long child; // the cell the edge goes to, as i * (n + 1) + j
+    int parent; // the index of the cell it comes from in its level
+} DagEdge;
+
+// the state shared by the threads of one lcsWavefront fill
+typedef struct {
+    const char *X, *Y;
+    int m, n;
+    int **dp, **choiceMatrix;
+    int tileSize, tileRows, tileCols;
+    atomic_int *claimed; // for every anti-diagonal of tiles, how many of its tiles have been taken
+    pthread_barrier_t barrier;
+} WavefrontJob;
 
 //Function prototypes, they are explained in detail in their own sections
-void printMatrix(int matrix[MAX][MAX], int len1, int len2);
-void findAllLCS(int dp[MAX][MAX], int choiceMatrix[MAX][MAX], char* X, char* Y, int m, int n, char* lcs, int index);
-int lcs(char *X, char *Y, int m, int n, int dp[MAX][MAX], int choiceMatrix[MAX][MAX], int showMatrix);
+void printMatrix(int **matrix, int len1, int len2);
+long long enumerateLCS(int **dp, const char *X, int m, const char *Y, int n, long long limit, LcsCallback callback, void *context);
+void flushOutput(OutputBuffer *buffer);
+int bufferLCS(const char *lcs, int length, void *context);
+uint64_t countLCS(int **dp, const char *X, int m, const char *Y, int n, int *overflow);
+char *countLCSExact(int **dp, const char *X, int m, const char *Y, int n);
+int lcs(char *X, char *Y, int m, int n, int **dp, int **choiceMatrix, int showMatrix);
 char getChoice(const char *prompt);
 void printAllLCS(char *X, char *Y);
+int **createMatrix(int rows, int cols);
+void freeMatrix(int **matrix);
+char *readToken(void);
+char *readFile(const char *path, int *length);
+char *hirschbergLCS(const char *X, int m, const char *Y, int n, int *length);
+double getTimeInSeconds(void);
+long peakMemoryKB(void);
+void benchmarkHirschberg(int maxLength);
+void selectLcsKernel(int allowSimd);
+int lcsLengthBitParallel(const char *X, int m, const char *Y, int n);
+void benchmarkBitParallel(int maxLength);
+int lcsWavefront(char *X, char *Y, int m, int n, int **dp, int **choiceMatrix, int tileSize, int threadCount);
+int onlineProcessors(void);
+void benchmarkWavefront(int length, int tileSize, int maxThreads);
+
+static void bitLcsScalar(const uint64_t *masks, int words, const unsigned char *text, int textLength, uint64_t *V);
+
+// the kernel used by lcsLengthBitParallel, selectLcsKernel sets it to the AVX2 one when the CPU supports it
+static LcsKernel lcsKernel = bitLcsScalar;
 
 /*
     @brief This function prints a matrix.
-    @param matrix[MAX][MAX] -> the matrix to be printed
+    @param matrix -> the matrix to be printed
     @param len1 -> the number of rows in the matrix
     @param len2 -> the number of columns in the matrix
     @return
 */
-void printMatrix(int matrix[MAX][MAX], int len1, int len2) {
+void printMatrix(int **matrix, int len1, int len2) {
     int i,j;
     for (i = 0; i <= len1; i++) {
         for (j = 0; j <= len2; j++) {
@@ -50,51 +161,379 @@ void printMatrix(int matrix[MAX][MAX], int len1, int len2) {
 }
 
 /*
-    @brief This recursive function finds and prints all Longest Common Subsequences (LCS).
-    @param dp[MAX][MAX] -> the DP matrix for LCS calculation
-    @param choiceMatrix[MAX][MAX] -> the choice matrix for backtracking LCS
+    @brief This function builds the previous-occurrence tables of the LCS DAG. Only the characters that are in both
+           strings can be in an LCS, they are numbered 0 .. sigma - 1 in byte order.
     @param X -> the first input string
+    @param m -> the length of the first string
     @param Y -> the second input string
+    @param n -> the length of the second string
+    @param symbols -> filled with the character of every number, 256 entries
+    @param previousX -> set to the table of X: (*previousX)[i * sigma + c] is the last position p < i with
+                        X[p] = symbols[c], or -1, for i = 0 .. m
+    @param previousY -> set to the table of Y, the same way
+    @return sigma, the number of characters in both strings
+*/
+static int previousOccurrences(const char *X, int m, const char *Y, int n, unsigned char *symbols, int **previousX, int **previousY) {
+    int symbolIndex[256], inX[256] = {0}, inY[256] = {0};
+    int sigma = 0, i, c;
+    int *tableX, *tableY;
+
+    for (i = 0; i < m; i++) inX[(unsigned char)X[i]] = 1;
+    for (i = 0; i < n; i++) inY[(unsigned char)Y[i]] = 1;
+    for (c = 0; c < 256; c++) {
+        symbolIndex[c] = -1;
+        if (inX[c] && inY[c]) { // a character missing from one of the strings is never in an LCS
+            symbolIndex[c] = sigma;
+            symbols[sigma++] = (unsigned char)c;
+        }
+    }
+
+    tableX = (int *)malloc(((size_t)m + 1) * (sigma > 0 ? sigma : 1) * sizeof(int));
+    tableY = (int *)malloc(((size_t)n + 1) * (sigma > 0 ? sigma : 1) * sizeof(int));
+    for (c = 0; c < sigma; c++) {
+        tableX[c] = -1;
+        tableY[c] = -1;
+    }
+    for (i = 1; i <= m; i++) {
+        memcpy(tableX + (size_t)i * sigma, tableX + (size_t)(i - 1) * sigma, sigma * sizeof(int));
+        if (symbolIndex[(unsigned char)X[i - 1]] >= 0) tableX[(size_t)i * sigma + symbolIndex[(unsigned char)X[i - 1]]] = i - 1;
+    }
+    for (i = 1; i <= n; i++) {
+        memcpy(tableY + (size_t)i * sigma, tableY + (size_t)(i - 1) * sigma, sigma * sizeof(int));
+        if (symbolIndex[(unsigned char)Y[i - 1]] >= 0) tableY[(size_t)i * sigma + symbolIndex[(unsigned char)Y[i - 1]]] = i - 1;
+    }
+
+    *previousX = tableX;
+    *previousY = tableY;
+    return sigma;
+}
+
+/*
+    @brief This function calls callback once for every distinct LCS of X and Y, at most limit times. It walks the
+           LCS DAG of the prefix DP from (m, n) backwards: from a cell (i, j) with dp[i][j] = k, a character c is
+           an edge when its last occurrences p in X[0..i) and q in Y[0..j) have dp[p][q] = k - 1, and the edge goes
+           to (p, q). Taking only the last occurrences gives every distinct string exactly one path, so nothing is
+           printed twice, and every edge leads to at least one LCS, so the time between two outputs is
+           O(length * alphabet). The last occurrences come from previous-occurrence tables, one row per prefix.
+    @param dp -> the DP matrix filled by lcs or lcsWavefront, (m + 1) x (n + 1)
+    @param X -> the first input string
     @param m -> the length of the first string
+    @param Y -> the second input string
     @param n -> the length of the second string
-    @param lcs -> a character array to store the LCS
-    @param index -> the current index in the LCS string
+    @param limit -> the largest number of strings to report, 0 or less for no limit
+    @param callback -> called with each LCS (null-terminated) and its length, returning nonzero stops the enumeration
+    @param context -> passed to callback as it is
+    @return the number of LCS reported
+*/
+long long enumerateLCS(int **dp, const char *X, int m, const char *Y, int n, long long limit, LcsCallback callback, void *context) {
+    unsigned char symbols[256];
+    int sigma, length = dp[m][n], top, c;
+    long long reported = 0;
+    int *previousX, *previousY;
+    char *lcs;
+    struct { int i, j, next; } *frames;
+
+    sigma = previousOccurrences(X, m, Y, n, symbols, &previousX, &previousY);
+
+    // frames[k] is the cell with k characters left to choose and the next character to try there
+    frames = malloc(((size_t)length + 1) * sizeof(*frames));
+    lcs = (char *)malloc((size_t)length + 1);
+    lcs[length] = '\0';
+    frames[length].i = m;
+    frames[length].j = n;
+    frames[length].next = 0;
+    top = length;
+    while (top <= length) {
+        if (top == 0) {
+            reported++;
+            if (callback(lcs, length, context) != 0 || reported == limit) break;
+            top++;
+            continue;
+        }
+        int found = 0;
+        while (!found && frames[top].next < sigma) {
+            int p, q;
+            c = frames[top].next++;
+            p = previousX[(size_t)frames[top].i * sigma + c];
+            q = previousY[(size_t)frames[top].j * sigma + c];
+            if (p >= 0 && q >= 0 && dp[p][q] == top - 1) {
+                lcs[top - 1] = (char)symbols[c];
+                frames[top - 1].i = p;
+                frames[top - 1].j = q;
+                frames[top - 1].next = 0;
+                found = 1;
+            }
+        }
+        top += found ? -1 : 1; // go down the new edge, or back up when this cell has no more
+    }
+
+    free(frames);
+    free(lcs);
+    free(previousX);
+    free(previousY);
+    return reported;
+}
+
+/*
+    @brief This function writes everything in the output buffer to its stream.
+    @param buffer -> the output buffer
     @return
 */
-void findAllLCS(int dp[MAX][MAX], int choiceMatrix[MAX][MAX], char* X, char* Y, int m, int n, char* lcs, int index) {
-    int i, j;
-    if (index == -1) {
-        printf("%s\n", lcs); // Print the LCS found
-        return;
+void flushOutput(OutputBuffer *buffer) {
+    fwrite(buffer->data, 1, buffer->used, buffer->stream);
+    buffer->used = 0;
+}
+
+/*
+    @brief This function is an enumerateLCS callback that copies the LCS and a newline into an output buffer, which
+           is written out only when it is full, instead of one printf per string.
+    @param lcs -> the LCS
+    @param length -> the length of the LCS
+    @param context -> the OutputBuffer
+    @return 0, to go on with the enumeration
+*/
+int bufferLCS(const char *lcs, int length, void *context) {
+    OutputBuffer *buffer = (OutputBuffer *)context;
+    if (buffer->used + length + 1 > sizeof(buffer->data)) {
+        flushOutput(buffer);
+        if ((size_t)length + 1 > sizeof(buffer->data)) { // longer than the whole buffer
+            fwrite(lcs, 1, length, buffer->stream);
+            fputc('\n', buffer->stream);
+            return 0;
+        }
     }
+    memcpy(buffer->data + buffer->used, lcs, length);
+    buffer->used += length;
+    buffer->data[buffer->used++] = '\n';
+    return 0;
+}
+
+/*
+    @brief This function sorts DAG edges by their child cell, for qsort.
+    @param a -> the first edge
+    @param b -> the second edge
+    @return negative, zero or positive like strcmp
+*/
+static int compareEdges(const void *a, const void *b) {
+    const DagEdge *x = (const DagEdge *)a, *y = (const DagEdge *)b;
+    return x->child < y->child ? -1 : x->child > y->child;
+}
+
+/*
+    @brief This function finds the edges from the cells of one level of the LCS DAG (the cells with level characters
+           left, as in enumerateLCS) to the next level and sorts them by child, so the edges into the same child
+           are next to each other.
+    @param dp -> the DP matrix
+    @param n -> the length of the second string
+    @param sigma -> the number of characters, from previousOccurrences
+    @param previousX -> the previous-occurrence table of the first string
+    @param previousY -> the previous-occurrence table of the second string
+    @param cells -> the cells of the level, as i * (n + 1) + j
+    @param count -> the number of cells
+    @param level -> the dp value of the cells
+    @param edges -> set to the edges, to be freed by the caller
+    @return the number of edges
+*/
+static int dagEdges(int **dp, int n, int sigma, const int *previousX, const int *previousY, const long long *cells, int count, int level, DagEdge **edges) {
+    DagEdge *list = (DagEdge *)malloc(((size_t)count * sigma + 1) * sizeof(DagEdge));
+    int edgeCount = 0, k, c;
+
+    for (k = 0; k < count; k++) {
+        int i = (int)(cells[k] / (n + 1)), j = (int)(cells[k] % (n + 1));
+        for (c = 0; c < sigma; c++) {
+            int p = previousX[(size_t)i * sigma + c], q = previousY[(size_t)j * sigma + c];
+            if (p >= 0 && q >= 0 && dp[p][q] == level - 1) {
+                list[edgeCount].child = (long long)p * (n + 1) + q;
+                list[edgeCount++].parent = k;
+            }
+        }
+    }
+    qsort(list, edgeCount, sizeof(DagEdge), compareEdges);
+    *edges = list;
+    return edgeCount;
+}
 
-    // Loop to find all paths for LCS
-    for (i = m; i > 0; i--) {
-        for (j = n; j > 0; j--) {
-            // Check if current cell is part of any LCS
-            if (dp[i][j] == index + 1 && X[i - 1] == Y[j - 1]) {
-                // Recur for the cell (i-1, j-1) in the matrix
-                if (choiceMatrix[i][j] == 1) {
-                    lcs[index] = X[i - 1];
-                    findAllLCS(dp, choiceMatrix, X, Y, i - 1, j - 1, lcs, index - 1);
-                }
+/*
+    @brief This function counts the distinct LCS of X and Y without listing them. Every distinct LCS is one path
+           of the LCS DAG that enumerateLCS walks, so it counts the paths: going down the levels from (m, n), the
+           count of a cell is the sum of the counts of the cells with an edge into it. Only two levels are kept and
+           every cell tries each character once, so it is O(m * n * alphabet) at worst. The count is 64-bit; when it
+           does not fit, UINT64_MAX is returned and *overflow is set, and countLCSExact gives the exact number.
+    @param dp -> the DP matrix filled by lcs or lcsWavefront, (m + 1) x (n + 1)
+    @param X -> the first input string
+    @param m -> the length of the first string
+    @param Y -> the second input string
+    @param n -> the length of the second string
+    @param overflow -> set to 1 if the count does not fit in 64 bits, otherwise to 0
+    @return the number of distinct LCS
+*/
+uint64_t countLCS(int **dp, const char *X, int m, const char *Y, int n, int *overflow) {
+    unsigned char symbols[256];
+    int *previousX, *previousY, sigma, level, count = 1, k;
+    long long *cells = (long long *)malloc(sizeof(long long));
+    uint64_t *ways = (uint64_t *)malloc(sizeof(uint64_t)), total = 0;
+
+    *overflow = 0;
+    sigma = previousOccurrences(X, m, Y, n, symbols, &previousX, &previousY);
+    cells[0] = (long long)m * (n + 1) + n;
+    ways[0] = 1;
+    for (level = dp[m][n]; level > 0; level--) {
+        DagEdge *edges;
+        int edgeCount = dagEdges(dp, n, sigma, previousX, previousY, cells, count, level, &edges), children = 0, e;
+        long long *childCells = (long long *)malloc(((size_t)edgeCount + 1) * sizeof(long long));
+        uint64_t *childWays = (uint64_t *)malloc(((size_t)edgeCount + 1) * sizeof(uint64_t));
+
+        for (e = 0; e < edgeCount; e++) {
+            if (e == 0 || edges[e].child != edges[e - 1].child) {
+                childCells[children] = edges[e].child;
+                childWays[children++] = 0;
+            }
+            if (__builtin_add_overflow(childWays[children - 1], ways[edges[e].parent], &childWays[children - 1])) {
+                childWays[children - 1] = UINT64_MAX;
+                *overflow = 1;
             }
         }
+        free(edges);
+        free(cells);
+        free(ways);
+        cells = childCells;
+        ways = childWays;
+        count = children;
+    }
+    for (k = 0; k < count; k++) {
+        if (__builtin_add_overflow(total, ways[k], &total)) {
+            total = UINT64_MAX;
+            *overflow = 1;
+        }
+    }
+
+    free(cells);
+    free(ways);
+    free(previousX);
+    free(previousY);
+    return *overflow ? UINT64_MAX : total;
+}
+
+/*
+    @brief This function adds a number of limbs to another, little-endian 32-bit limbs.
+    @param sum -> the number added to, limbs long
+    @param value -> the number to add, at most limbs long
+    @param valueLimbs -> the number of limbs of value
+    @param limbs -> the number of limbs of sum, the result must fit in it
+    @return
+*/
+static void addLimbs(uint32_t *sum, const uint32_t *value, int valueLimbs, int limbs) {
+    uint64_t carry = 0;
+    int k;
+    for (k = 0; k < limbs && (k < valueLimbs || carry); k++) {
+        carry += (uint64_t)sum[k] + (k < valueLimbs ? value[k] : 0);
+        sum[k] = (uint32_t)carry;
+        carry >>= 32;
     }
 }
 
+/*
+    @brief This function counts the distinct LCS like countLCS, with arbitrary-precision numbers. Every cell of a
+           level has the same number of 32-bit limbs; a level gets one more limb than the level above (a cell has
+           fewer than 2^32 incoming edges) and the limbs that stay zero in every cell are cut off again.
+    @param dp -> the DP matrix filled by lcs or lcsWavefront, (m + 1) x (n + 1)
+    @param X -> the first input string
+    @param m -> the length of the first string
+    @param Y -> the second input string
+    @param n -> the length of the second string
+    @return the number of distinct LCS in decimal, to be freed by the caller
+*/
+char *countLCSExact(int **dp, const char *X, int m, const char *Y, int n) {
+    unsigned char symbols[256];
+    int *previousX, *previousY, sigma, level, count = 1, limbs = 1, used, k, digits = 0;
+    long long *cells = (long long *)malloc(sizeof(long long));
+    uint32_t *ways = (uint32_t *)malloc(sizeof(uint32_t)), *total;
+    char *decimal;
+
+    sigma = previousOccurrences(X, m, Y, n, symbols, &previousX, &previousY);
+    cells[0] = (long long)m * (n + 1) + n;
+    ways[0] = 1;
+    for (level = dp[m][n]; level > 0; level--) {
+        DagEdge *edges;
+        int edgeCount = dagEdges(dp, n, sigma, previousX, previousY, cells, count, level, &edges), children = 0, e;
+        int childLimbs = limbs + 1;
+        long long *childCells = (long long *)malloc(((size_t)edgeCount + 1) * sizeof(long long));
+        uint32_t *childWays = (uint32_t *)calloc(((size_t)edgeCount + 1) * childLimbs, sizeof(uint32_t));
+
+        for (e = 0; e < edgeCount; e++) {
+            if (e == 0 || edges[e].child != edges[e - 1].child) {
+                childCells[children++] = edges[e].child;
+            }
+            addLimbs(childWays + (size_t)(children - 1) * childLimbs, ways + (size_t)edges[e].parent * limbs, limbs, childLimbs);
+        }
+        used = 1; // the most limbs any cell of the level needs
+        for (k = 0; k < children; k++) {
+            int top = childLimbs;
+            while (top > used && childWays[(size_t)k * childLimbs + top - 1] == 0) top--;
+            used = top;
+        }
+        if (used < childLimbs) { // pack the cells with the shorter stride, in place from the front
+            for (k = 0; k < children; k++) {
+                memmove(childWays + (size_t)k * used, childWays + (size_t)k * childLimbs, used * sizeof(uint32_t));
+            }
+            childLimbs = used;
+        }
+        free(edges);
+        free(cells);
+        free(ways);
+        cells = childCells;
+        ways = childWays;
+        count = children;
+        limbs = childLimbs;
+    }
+    total = (uint32_t *)calloc((size_t)limbs + 1, sizeof(uint32_t));
+    for (k = 0; k < count; k++) {
+        addLimbs(total, ways + (size_t)k * limbs, limbs, limbs + 1);
+    }
+
+    // to decimal: divide by 10^9 until nothing is left, every division gives the next 9 digits from the right
+    decimal = (char *)malloc((size_t)(limbs + 1) * 10 + 2);
+    used = limbs + 1;
+    do {
+        uint64_t remainder = 0;
+        for (k = used - 1; k >= 0; k--) {
+            uint64_t current = (remainder << 32) | total[k];
+            total[k] = (uint32_t)(current / 1000000000);
+            remainder = current % 1000000000;
+        }
+        while (used > 0 && total[used - 1] == 0) used--;
+        for (k = 0; k < 9 && (used > 0 || remainder > 0 || k == 0); k++) {
+            decimal[digits++] = (char)('0' + remainder % 10);
+            remainder /= 10;
+        }
+    } while (used > 0);
+    decimal[digits] = '\0';
+    for (k = 0; k < digits / 2; k++) { // the digits were written from the right
+        char c = decimal[k];
+        decimal[k] = decimal[digits - 1 - k];
+        decimal[digits - 1 - k] = c;
+    }
+
+    free(total);
+    free(cells);
+    free(ways);
+    free(previousX);
+    free(previousY);
+    return decimal;
+}
+
  /*
     @brief This function calculates the length of Longest Common Subsequence (LCS) and fills DP and choice matrices.
     @param X -> the first input string
     @param Y -> the second input string
     @param m -> the length of the first string
     @param n -> the length of the second string
-    @param dp[MAX][MAX] -> the DP matrix for LCS calculation
-    @param choiceMatrix[MAX][MAX] -> the choice matrix for backtracking LCS
+    @param dp -> the DP matrix for LCS calculation, (m + 1) x (n + 1)
+    @param choiceMatrix -> the choice matrix for backtracking LCS, (m + 1) x (n + 1)
     @param showMatrix -> a flag to determine if matrices should be displayed
     @return the length of LCS
 */
-int lcs(char *X, char *Y, int m, int n, int dp[MAX][MAX], int choiceMatrix[MAX][MAX], int showMatrix) {
+int lcs(char *X, char *Y, int m, int n, int **dp, int **choiceMatrix, int showMatrix) {
     int i,j;
     for (i = 0; i <= m; i++) {
         for (j = 0; j <= n; j++) {
@@ -145,14 +584,30 @@ char getChoice(const char *prompt) {
 void printAllLCS(char *X, char *Y) {
     int m = strlen(X);
     int n = strlen(Y);
-    int dp[MAX][MAX] = {{0}};
-    int choiceMatrix[MAX][MAX] = {{0}};
+
+    if ((long long)(m + 1) * (n + 1) > FULL_MATRIX_LIMIT) {
+        int lcsLength;
+        char *oneLCS = hirschbergLCS(X, m, Y, n, &lcsLength);
+        printf("\nThe strings are too long for the full matrices (%d x %d), one LCS is found in linear space.\n", m, n);
+        printf("\nLCS length of the given strings is: %d\n", lcsLength);
+        printf("\nOne LCS is:\n%s\n", oneLCS);
+        free(oneLCS);
+        return;
+    }
+
+    int **dp = createMatrix(m + 1, n + 1);
+    int **choiceMatrix = createMatrix(m + 1, n + 1);
 
     char showMatrixChoice = getChoice("Do you want to see the matrices row by row after the implementation? (Y/N): ");
 
     int showMatrix = showMatrixChoice == 'Y' || showMatrixChoice == 'y';
 
-    int lcsLength = lcs(X, Y, m, n, dp, choiceMatrix, showMatrix);
+    int lcsLength;
+    if (!showMatrix && (long long)(m + 1) * (n + 1) >= WAVEFRONT_MIN_CELLS) {
+        lcsLength = lcsWavefront(X, Y, m, n, dp, choiceMatrix, WAVEFRONT_TILE, onlineProcessors());
+    } else {
+        lcsLength = lcs(X, Y, m, n, dp, choiceMatrix, showMatrix);
+    }
 
     char showFinalMatrixChoice = getChoice("Would you like to see the matrix created with the dynamic programming approach in detail? (Y/N): ");
     if (showFinalMatrixChoice == 'Y' || showFinalMatrixChoice == 'y') {
@@ -165,33 +620,958 @@ void printAllLCS(char *X, char *Y) {
     printf("\n************************************************************************\n");
 
     printf("\nLCS length of the given strings is: %d\n", lcsLength);
+    int overflow;
+    uint64_t lcsCount = countLCS(dp, X, m, Y, n, &overflow);
+    if (overflow) {
+        char *exactCount = countLCSExact(dp, X, m, Y, n);
+        printf("\nNumber of distinct LCS: %s\n", exactCount);
+        free(exactCount);
+    } else {
+        printf("\nNumber of distinct LCS: %llu\n", (unsigned long long)lcsCount);
+    }
     printf("\n****************** All LCS ******************\n");
 
-    char* lcs = (char*)malloc((lcsLength + 1) * sizeof(char));
-    lcs[lcsLength] = '\0'; // Null-terminate the string
-
     printf("\nLCS of %s and %s is/are below here:\n", X, Y);
+    fflush(stdout); // the LCS strings go through their own buffer
+
+    OutputBuffer *output = (OutputBuffer *)malloc(sizeof(OutputBuffer));
+    output->stream = stdout;
+    output->used = 0;
+    enumerateLCS(dp, X, m, Y, n, 0, bufferLCS, output);
+    flushOutput(output);
+
+    free(output); // Free allocated memory
+    freeMatrix(dp);
+    freeMatrix(choiceMatrix);
+}
+
+/*
+    @brief This function allocates a rows x cols int matrix on the heap, filled with zeros. The cells are one
+           contiguous block and the returned row pointers point into it, so matrix[i][j] works as before.
+    @param rows -> the number of rows
+    @param cols -> the number of columns
+    @return the row pointers of the matrix, to be freed with freeMatrix
+*/
+int **createMatrix(int rows, int cols) {
+    int **matrix = (int **)malloc((size_t)rows * sizeof(int *));
+    int *cells = (int *)calloc((size_t)rows * cols, sizeof(int));
+    int i;
+    for (i = 0; i < rows; i++) {
+        matrix[i] = cells + (size_t)i * cols;
+    }
+    return matrix;
+}
+
+/*
+    @brief This function frees a matrix allocated with createMatrix.
+    @param matrix -> the matrix to be freed
+    @return
+*/
+void freeMatrix(int **matrix) {
+    free(matrix[0]);
+    free(matrix);
+}
+
+/*
+    @brief This function reads one whitespace separated word of any length from the standard input.
+    @return the word in a heap buffer, or NULL at the end of the input
+*/
+char *readToken(void) {
+    size_t capacity = 64, length = 0;
+    char *buffer;
+    int c;
+
+    do {
+        c = getchar();
+    } while (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+    if (c == EOF) {
+        return NULL;
+    }
+    buffer = (char *)malloc(capacity);
+    while (c != EOF && c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+        if (length + 1 == capacity) {
+            capacity *= 2;
+            buffer = (char *)realloc(buffer, capacity);
+        }
+        buffer[length++] = (char)c;
+        c = getchar();
+    }
+    buffer[length] = '\0';
+    return buffer;
+}
+
+/*
+    @brief This function reads a whole file into a null terminated heap buffer. A trailing newline is removed,
+           so a sequence saved by a text editor compares the same as the bare sequence.
+    @param path -> the path of the file
+    @param length -> the length of the content is written here
+    @return the content, or NULL if the file cannot be read
+*/
+char *readFile(const char *path, int *length) {
+    FILE *file = fopen(path, "rb");
+    char *buffer;
+    long size;
+
+    if (file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || size > 0x7FFFFFFEL) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        if (file != NULL) fclose(file);
+        return NULL;
+    }
+    rewind(file);
+    buffer = (char *)malloc((size_t)size + 1);
+    size = (long)fread(buffer, 1, (size_t)size, file);
+    fclose(file);
+    while (size > 0 && (buffer[size - 1] == '\n' || buffer[size - 1] == '\r')) {
+        size--;
+    }
+    buffer[size] = '\0';
+    *length = (int)size;
+    return buffer;
+}
+
+/*
+    @brief This function computes the last row of the LCS DP of X and Y with two rolling rows:
+           row[j] = LCS length of X[0..m) and Y[0..j).
+    @param X -> the first string
+    @param m -> the length of X
+    @param Y -> the second string
+    @param n -> the length of Y
+    @param current -> a row of n + 1 ints
+    @param previous -> another row of n + 1 ints
+    @return the row that holds the result (current or previous)
+*/
+static int *lcsRowForward(const char *X, int m, const char *Y, int n, int *current, int *previous) {
+    int i, j;
+    memset(current, 0, (size_t)(n + 1) * sizeof(int));
+    for (i = 0; i < m; i++) {
+        int *swap = previous;
+        char x = X[i];
+        previous = current;
+        current = swap;
+        current[0] = 0;
+        for (j = 1; j <= n; j++) {
+            // previous[j] is previous[j - 1] or one more, so a match adds 0 or 1 without a branch; a match is never
+            // smaller than the left cell, so only one max depends on the previous column
+            int fromAbove = previous[j] + ((x == Y[j - 1]) & (previous[j - 1] + 1 - previous[j]));
+            current[j] = fromAbove > current[j - 1] ? fromAbove : current[j - 1];
+        }
+    }
+    return current;
+}
 
-    findAllLCS(dp, choiceMatrix, X, Y, m, n, lcs, lcsLength - 1);
+/*
+    @brief This function is the mirror of lcsRowForward, it runs the DP from the ends of the strings:
+           row[j] = LCS length of X[0..m) and Y[j..n).
+    @param X -> the first string
+    @param m -> the length of X
+    @param Y -> the second string
+    @param n -> the length of Y
+    @param current -> a row of n + 1 ints
+    @param previous -> another row of n + 1 ints
+    @return the row that holds the result (current or previous)
+*/
+static int *lcsRowBackward(const char *X, int m, const char *Y, int n, int *current, int *previous) {
+    int i, j;
+    memset(current, 0, (size_t)(n + 1) * sizeof(int));
+    for (i = m - 1; i >= 0; i--) {
+        int *swap = previous;
+        char x = X[i];
+        previous = current;
+        current = swap;
+        current[n] = 0;
+        for (j = n - 1; j >= 0; j--) {
+            int fromAbove = previous[j] + ((x == Y[j]) & (previous[j + 1] + 1 - previous[j]));
+            current[j] = fromAbove > current[j + 1] ? fromAbove : current[j + 1];
+        }
+    }
+    return current;
+}
 
-    free(lcs); // Free allocated memory
+/*
+    @brief This recursive function is the divide step of Hirschberg's algorithm. The middle row of X splits the
+           problem: the forward row of the top half and the backward row of the bottom half are computed, the
+           column k with the biggest sum is where an optimal path crosses the middle row, and the two halves
+           (X top with Y[0..k), X bottom with Y[k..n)) are solved on their own. The rows of the subproblems are
+           shorter, so the same four rows are reused all the way down.
+    @param X -> the first string
+    @param m -> the length of X
+    @param Y -> the second string
+    @param n -> the length of Y
+    @param out -> the LCS characters are written here
+    @param rows -> four rows of at least n + 1 ints
+    @return the number of characters written to out
+*/
+static int hirschbergSolve(const char *X, int m, const char *Y, int n, char *out, int **rows) {
+    int mid = m / 2, best = -1, split = 0, j, left;
+    int *forward, *backward;
+
+    if (m == 0 || n == 0) {
+        return 0;
+    }
+    if (m == 1 || n == 1) {
+        // one of the strings is a single character, the LCS is that character if the other string has it
+        const char *single = m == 1 ? X : Y;
+        const char *other = m == 1 ? Y : X;
+        if (memchr(other, single[0], (size_t)(m == 1 ? n : m)) == NULL) {
+            return 0;
+        }
+        out[0] = single[0];
+        return 1;
+    }
+
+    forward = lcsRowForward(X, mid, Y, n, rows[0], rows[1]);
+    backward = lcsRowBackward(X + mid, m - mid, Y, n, rows[2], rows[3]);
+    for (j = 0; j <= n; j++) {
+        if (forward[j] + backward[j] > best) {
+            best = forward[j] + backward[j];
+            split = j;
+        }
+    }
+
+    left = hirschbergSolve(X, mid, Y, split, out, rows);
+    return left + hirschbergSolve(X + mid, m - mid, Y + split, n - split, out + left, rows);
+}
+
+/*
+    @brief This function finds one Longest Common Subsequence of two strings of any length in O(m + n) memory with
+           Hirschberg's algorithm. The common prefix and suffix are part of some LCS, so they are copied directly
+           and only the middle is solved. The DP rows run over the shorter string.
+    @param X -> the first string
+    @param m -> the length of X
+    @param Y -> the second string
+    @param n -> the length of Y
+    @param length -> the length of the LCS is written here
+    @return the LCS as a null terminated heap string
+*/
+char *hirschbergLCS(const char *X, int m, const char *Y, int n, int *length) {
+    int prefix = 0, suffix = 0, count, i;
+    char *out;
+    int *rows[4];
+
+    if (n > m) {
+        const char *swapString = X;
+        int swapLength = m;
+        X = Y;
+        m = n;
+        Y = swapString;
+        n = swapLength;
+    }
+    out = (char *)malloc((size_t)n + 1);
+    while (prefix < n && X[prefix] == Y[prefix]) {
+        prefix++;
+    }
+    while (suffix < n - prefix && X[m - 1 - suffix] == Y[n - 1 - suffix]) {
+        suffix++;
+    }
+    memcpy(out, Y, (size_t)prefix);
+
+    rows[0] = (int *)malloc(4 * ((size_t)n + 1) * sizeof(int));
+    for (i = 1; i < 4; i++) {
+        rows[i] = rows[0] + i * ((size_t)n + 1);
+    }
+    count = prefix + hirschbergSolve(X + prefix, m - prefix - suffix, Y + prefix, n - prefix - suffix, out + prefix, rows);
+    free(rows[0]);
+
+    memcpy(out + count, Y + n - suffix, (size_t)suffix);
+    count += suffix;
+    out[count] = '\0';
+    *length = count;
+    return out;
+}
+
+/*
+    @brief This function returns the value of the monotonic clock for the benchmarks.
+    @return the time in seconds
+*/
+double getTimeInSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+    @brief This function returns the peak resident memory of the process so far.
+    @return the peak memory in KB
+*/
+long peakMemoryKB(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/*
+    @brief This function fills a buffer with random characters from an alphabet (xorshift generator).
+    @param buffer -> at least length + 1 bytes
+    @param length -> the number of characters
+    @param alphabet -> the characters to choose from
+    @param state -> the state of the generator
+    @return
+*/
+static void randomString(char *buffer, int length, const char *alphabet, unsigned long long *state) {
+    int size = (int)strlen(alphabet), i;
+    for (i = 0; i < length; i++) {
+        *state ^= *state << 13;
+        *state ^= *state >> 7;
+        *state ^= *state << 17;
+        buffer[i] = alphabet[(*state >> 32) % size];
+    }
+    buffer[length] = '\0';
+}
+
+/*
+    @brief This function checks that sub is a subsequence of text.
+    @param sub -> the subsequence
+    @param text -> the text
+    @return 1 if it is, 0 if not
+*/
+static int isSubsequence(const char *sub, const char *text) {
+    while (*sub != '\0' && *text != '\0') {
+        if (*sub == *text) sub++;
+        text++;
+    }
+    return *sub == '\0';
+}
+
+/*
+    @brief This function runs Hirschberg on two random DNA-like strings (alphabet ACGT) of length 1000, 10000, ...
+           up to maxLength and prints the LCS length, the runtime, the DP cells per second and the peak memory of the
+           process. The result is always checked to be a subsequence of both strings, and for short strings its
+           length is compared with the full matrix lcs.
+    @param maxLength -> the length of the longest pair
+    @return
+*/
+void benchmarkHirschberg(int maxLength) {
+    unsigned long long state = 88172645463325252ULL;
+    int length;
+
+    printf("%10s %10s %10s %12s %14s %14s %8s\n", "length", "LCS", "seconds", "Mcells/s", "rows (KB)", "peak (KB)", "check");
+    if (maxLength < 1) maxLength = 1;
+    for (length = 1000;; length *= 10) {
+        char *X, *Y, *oneLCS;
+        int lcsLength, ok;
+        double start, elapsed;
+
+        if (length > maxLength) length = maxLength;
+        X = (char *)malloc((size_t)length + 1);
+        Y = (char *)malloc((size_t)length + 1);
+        randomString(X, length, "ACGT", &state);
+        randomString(Y, length, "ACGT", &state);
+
+        start = getTimeInSeconds();
+        oneLCS = hirschbergLCS(X, length, Y, length, &lcsLength);
+        elapsed = getTimeInSeconds() - start;
+
+        ok = (int)strlen(oneLCS) == lcsLength && isSubsequence(oneLCS, X) && isSubsequence(oneLCS, Y);
+        if (ok && length <= 5000) {
+            int **dp = createMatrix(length + 1, length + 1);
+            int **choiceMatrix = createMatrix(length + 1, length + 1);
+            ok = lcs(X, Y, length, length, dp, choiceMatrix, 0) == lcsLength;
+            freeMatrix(dp);
+            freeMatrix(choiceMatrix);
+        }
+        printf("%10d %10d %10.2f %12.1f %14zu %14ld %8s\n", length, lcsLength, elapsed,
+               (double)length * length / elapsed / 1e6, 4 * ((size_t)length + 1) * sizeof(int) / 1024, peakMemoryKB(),
+               ok ? "ok" : "WRONG");
+
+        free(oneLCS);
+        free(X);
+        free(Y);
+        if (length == maxLength) break;
+    }
+}
+
+/*
+    @brief This function is the portable bit-parallel kernel (Allison-Dix, Hyyro). V is the bit vector of the
+           pattern, a 0 bit marks a pattern position that is matched in the current LCS. For every text character
+           with match mask M: U = V & M, V = (V + U) | (V - U). V - U never borrows (U is a subset of V), so it is
+           V & ~M; the addition carries from word to word.
+    @param masks -> the match masks, words 64-bit words per character of the compact alphabet
+    @param words -> the number of 64-bit words of the pattern
+    @param text -> the text as compact alphabet indexes, characters not in the pattern are already removed
+    @param textLength -> the number of characters in text
+    @param V -> the bit vector, updated in place
+    @return
+*/
+static void bitLcsScalar(const uint64_t *masks, int words, const unsigned char *text, int textLength, uint64_t *V) {
+    int r, w;
+    for (r = 0; r < textLength; r++) {
+        const uint64_t *M = masks + (size_t)text[r] * words;
+        uint64_t carry = 0;
+        for (w = 0; w < words; w++) {
+            uint64_t v = V[w], u = v & M[w];
+            uint64_t sum = v + u;
+            uint64_t carryOut = sum < v;
+            sum += carry;
+            carry = carryOut | (sum < carry);
+            V[w] = sum | (v & ~M[w]);
+        }
+    }
+}
+
+#ifdef HAVE_AVX2_KERNEL
+/*
+    @brief This function does the same job as bitLcsScalar with AVX2, four 64-bit words (256 DP cells) per vector
+           step. A vector add cannot carry between its lanes, so the carries are resolved like in a carry-lookahead
+           adder: every lane reports whether it generates a carry (the sum wrapped) or propagates one (the sum is
+           all ones), the two 4-bit masks are added as small integers together with the carry coming from the
+           previous step, and the bits of the result tell which lanes get +1 and whether a carry leaves the
+           vector. Only that one carry bit is passed from step to step, the rest of the work is independent.
+    @param masks -> the match masks, words 64-bit words per character of the compact alphabet
+    @param words -> the number of 64-bit words of the pattern
+    @param text -> the text as compact alphabet indexes
+    @param textLength -> the number of characters in text
+    @param V -> the bit vector, updated in place
+    @return
+*/
+__attribute__((target("avx2")))
+static void bitLcsAVX2(const uint64_t *masks, int words, const unsigned char *text, int textLength, uint64_t *V) {
+    const __m256i signBit = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256i laneBits = _mm256_set_epi64x(8, 4, 2, 1);
+    const __m256i allOnes = _mm256_set1_epi64x(-1);
+    int vectorWords = words & ~3, r, w;
+
+    for (r = 0; r < textLength; r++) {
+        const uint64_t *M = masks + (size_t)text[r] * words;
+        unsigned int carry = 0;
+        for (w = 0; w < vectorWords; w += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(V + w));
+            __m256i m = _mm256_loadu_si256((const __m256i *)(M + w));
+            __m256i sum = _mm256_add_epi64(v, _mm256_and_si256(v, m));
+            unsigned int generate = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpgt_epi64(_mm256_xor_si256(v, signBit), _mm256_xor_si256(sum, signBit))));
+            unsigned int propagate = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(sum, allOnes)));
+            unsigned int total = (generate | propagate) + generate + carry;
+            unsigned int carryIn = (total ^ (generate | propagate) ^ generate) & 15;
+            __m256i increment = _mm256_srli_epi64(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(carryIn), laneBits), laneBits), 63);
+            carry = total >> 4;
+            sum = _mm256_add_epi64(sum, increment);
+            _mm256_storeu_si256((__m256i *)(V + w), _mm256_or_si256(sum, _mm256_andnot_si256(m, v)));
+        }
+        for (; w < words; w++) {
+            uint64_t v = V[w], u = v & M[w], sum = v + u, carryOut = sum < v;
+            sum += carry;
+            carry = (unsigned int)(carryOut | (sum < carry));
+            V[w] = sum | (v & ~M[w]);
+        }
+    }
+}
+#endif
+
+/*
+    @brief This function chooses the kernel of lcsLengthBitParallel by looking at the CPU at runtime.
+    @param allowSimd -> 0 forces the portable kernel
+    @return
+*/
+void selectLcsKernel(int allowSimd) {
+    lcsKernel = bitLcsScalar;
+#ifdef HAVE_AVX2_KERNEL
+    if (allowSimd && __builtin_cpu_supports("avx2")) {
+        lcsKernel = bitLcsAVX2;
+    }
+#else
+    (void)allowSimd;
+#endif
+}
+
+/*
+    @brief This function computes only the LCS length with the given bit-parallel kernel. The shorter string is the
+           pattern: one match mask per character that appears in it, ceil(length / 64) words each. Text characters
+           that do not appear in the pattern cannot change V and are dropped before the kernel runs.
+    @param X -> the first string
+    @param m -> the length of X
+    @param Y -> the second string
+    @param n -> the length of Y
+    @param kernel -> bitLcsScalar or bitLcsAVX2
+    @return the LCS length
+*/
+static int bitParallelLength(const char *X, int m, const char *Y, int n, LcsKernel kernel) {
+    int alphabet[256], sigma = 0, words, textLength = 0, zeros = 0, i;
+    uint64_t *masks, *V;
+    unsigned char *text;
+
+    if (m > n) {
+        const char *swapString = X;
+        int swapLength = m;
+        X = Y;
+        m = n;
+        Y = swapString;
+        n = swapLength;
+    }
+    if (m == 0) {
+        return 0;
+    }
+    words = (m + 63) / 64;
+    memset(alphabet, -1, sizeof(alphabet));
+    for (i = 0; i < m; i++) {
+        unsigned char c = (unsigned char)X[i];
+        if (alphabet[c] == -1) alphabet[c] = sigma++;
+    }
+    masks = (uint64_t *)calloc((size_t)sigma * words, sizeof(uint64_t));
+    for (i = 0; i < m; i++) {
+        masks[(size_t)alphabet[(unsigned char)X[i]] * words + i / 64] |= 1ULL << (i % 64);
+    }
+    text = (unsigned char *)calloc((size_t)n + 1, 1);
+    for (i = 0; i < n; i++) {
+        int c = alphabet[(unsigned char)Y[i]];
+        if (c != -1) text[textLength++] = (unsigned char)c;
+    }
+    // the bits above m stay 1: their masks are 0, so V & ~M keeps them set
+    V = (uint64_t *)malloc((size_t)words * sizeof(uint64_t));
+    memset(V, 0xFF, (size_t)words * sizeof(uint64_t));
+
+    kernel(masks, words, text, textLength, V);
+
+    for (i = 0; i < words; i++) {
+        zeros += 64 - __builtin_popcountll(V[i]);
+    }
+    free(V);
+    free(text);
+    free(masks);
+    return zeros;
+}
+
+/*
+    @brief This function computes the LCS length of two strings of any length in O(m * n / 64) word operations
+           (O(m * n / 256) with AVX2) and O(m + n) memory, with the kernel chosen by selectLcsKernel. Use it when
+           only the length or a similarity score is needed.
+    @param X -> the first string
+    @param m -> the length of X
+    @param Y -> the second string
+    @param n -> the length of Y
+    @return the LCS length
+*/
+int lcsLengthBitParallel(const char *X, int m, const char *Y, int n) {
+    return bitParallelLength(X, m, Y, n, lcsKernel);
+}
+
+/*
+    @brief This function checks the bit-parallel kernels against lcs on many random pairs (lengths 0 - 600, so
+           the single word, vector and leftover-word paths are all used, alphabets of 2 to 26 letters) and then
+           times the cell-by-cell row DP and the kernels on random ACGT strings of length 1000, 10000, ... up to
+           maxLength. The row DP is skipped above 10^5 characters because it takes too long.
+    @param maxLength -> the length of the longest pair
+    @return
+*/
+void benchmarkBitParallel(int maxLength) {
+    static const char *alphabets[] = {"AB", "ACGT", "abcdefghijklmnopqrstuvwxyz"};
+    unsigned long long state = 2463534242ULL;
+    int kernelCount = 1, mismatches = 0, length, pair, k;
+    LcsKernel kernels[2] = {bitLcsScalar, bitLcsScalar};
+    char *X = (char *)malloc(601), *Y = (char *)malloc(601);
+
+#ifdef HAVE_AVX2_KERNEL
+    if (__builtin_cpu_supports("avx2")) {
+        kernels[1] = bitLcsAVX2;
+        kernelCount = 2;
+    }
+#endif
+    for (pair = 0; pair < 3000; pair++) {
+        int m = (int)(state % 601), n, expected, **dp, **choiceMatrix;
+        randomString(X, m, alphabets[pair % 3], &state);
+        n = (int)(state % 601);
+        randomString(Y, n, alphabets[pair % 3], &state);
+        dp = createMatrix(m + 1, n + 1);
+        choiceMatrix = createMatrix(m + 1, n + 1);
+        expected = lcs(X, Y, m, n, dp, choiceMatrix, 0);
+        for (k = 0; k < kernelCount; k++) {
+            mismatches += bitParallelLength(X, m, Y, n, kernels[k]) != expected;
+        }
+        freeMatrix(dp);
+        freeMatrix(choiceMatrix);
+    }
+    free(X);
+    free(Y);
+    printf("Cross-check against lcs on 3000 random pairs (%s): %d mismatches\n",
+           kernelCount == 2 ? "scalar and avx2" : "scalar, no AVX2 on this CPU", mismatches);
+
+    printf("%10s %10s %16s %16s %16s\n", "length", "LCS", "row DP Mcells/s", "scalar Mcells/s", "avx2 Mcells/s");
+    if (maxLength < 1) maxLength = 1;
+    for (length = 1000;; length *= 10) {
+        double rates[3] = {0, 0, 0}, cells, start;
+        int lengths[3] = {-1, -1, -1};
+
+        if (length > maxLength) length = maxLength;
+        X = (char *)malloc((size_t)length + 1);
+        Y = (char *)malloc((size_t)length + 1);
+        randomString(X, length, "ACGT", &state);
+        randomString(Y, length, "ACGT", &state);
+        cells = (double)length * length;
+
+        if (length <= 100000) {
+            int *rows = (int *)malloc(2 * ((size_t)length + 1) * sizeof(int));
+            start = getTimeInSeconds();
+            lengths[0] = lcsRowForward(X, length, Y, length, rows, rows + length + 1)[length];
+            rates[0] = cells / (getTimeInSeconds() - start) / 1e6;
+            free(rows);
+        }
+        for (k = 0; k < kernelCount; k++) {
+            start = getTimeInSeconds();
+            lengths[1 + k] = bitParallelLength(X, length, Y, length, kernels[k]);
+            rates[1 + k] = cells / (getTimeInSeconds() - start) / 1e6;
+        }
+        printf("%10d %10d", length, lengths[1]);
+        for (k = 0; k < 3; k++) {
+            if (rates[k] > 0) {
+                printf(" %16.0f", rates[k]);
+            } else {
+                printf(" %16s", "-"); // skipped or no AVX2
+            }
+        }
+        printf("%s\n", (lengths[0] != -1 && lengths[0] != lengths[1]) || (kernelCount == 2 && lengths[2] != lengths[1]) ? "  MISMATCH" : "");
+
+        free(X);
+        free(Y);
+        if (length == maxLength) break;
+    }
+}
+
+/*
+    @brief This function fills one tile of the DP and choice matrices, row by row, exactly like lcs does. The
+           tiles above it, to its left and above-left must already be filled.
+    @param job -> the wavefront fill the tile belongs to
+    @param tileRow -> the row of the tile in the grid of tiles
+    @param tileCol -> the column of the tile in the grid of tiles
+    @return
+*/
+static void fillTile(WavefrontJob *job, int tileRow, int tileCol) {
+    int rowStart = 1 + tileRow * job->tileSize, colStart = 1 + tileCol * job->tileSize;
+    int rowEnd = rowStart + job->tileSize, colEnd = colStart + job->tileSize;
+    int i, j;
+
+    if (rowEnd > job->m + 1) rowEnd = job->m + 1;
+    if (colEnd > job->n + 1) colEnd = job->n + 1;
+    for (i = rowStart; i < rowEnd; i++) {
+        const char x = job->X[i - 1];
+        const int *above = job->dp[i - 1];
+        int *current = job->dp[i], *choice = job->choiceMatrix[i];
+        for (j = colStart; j < colEnd; j++) {
+            // same cells as lcs, written with selects instead of branches: a match is a coin flip on random text
+            int up = above[j], left = current[j - 1], match = x == job->Y[j - 1];
+            int best = up > left ? up : left, bestChoice = up > left ? 2 : 3;
+            current[j] = match ? above[j - 1] + 1 : best;
+            choice[j] = match ? 1 : bestChoice;
+        }
+    }
+}
+
+/*
+    @brief This function is run by every thread of a wavefront fill. It goes over the anti-diagonals of tiles in
+           order, takes tiles of the current one until none is left and waits at the barrier for the others.
+    @param argument -> the WavefrontJob
+    @return NULL
+*/
+static void *wavefrontWorker(void *argument) {
+    WavefrontJob *job = (WavefrontJob *)argument;
+    int diagonal, diagonals = job->tileRows + job->tileCols - 1;
+
+    for (diagonal = 0; diagonal < diagonals; diagonal++) {
+        int first = diagonal - job->tileCols + 1 > 0 ? diagonal - job->tileCols + 1 : 0; // first tile row on it
+        int last = diagonal < job->tileRows - 1 ? diagonal : job->tileRows - 1;
+        int k;
+        while ((k = atomic_fetch_add_explicit(&job->claimed[diagonal], 1, memory_order_relaxed)) <= last - first) {
+            fillTile(job, first + k, diagonal - first - k);
+        }
+        pthread_barrier_wait(&job->barrier); // the barrier also makes the filled tiles visible to the other threads
+    }
+    return NULL;
+}
+
+/*
+    @brief This function fills the DP and choice matrices like lcs, but tile by tile along the anti-diagonals of
+           tiles, with threadCount threads working on the tiles of the same anti-diagonal. The calling thread is one
+           of them, so threadCount = 1 starts no thread and is a cache-blocked serial fill.
+    @param X -> the first input string
+    @param Y -> the second input string
+    @param m -> the length of the first string
+    @param n -> the length of the second string
+    @param dp -> the DP matrix for LCS calculation, (m + 1) x (n + 1)
+    @param choiceMatrix -> the choice matrix for backtracking LCS, (m + 1) x (n + 1)
+    @param tileSize -> the side of a tile in cells
+    @param threadCount -> the number of threads
+    @return the length of LCS
+*/
+int lcsWavefront(char *X, char *Y, int m, int n, int **dp, int **choiceMatrix, int tileSize, int threadCount) {
+    WavefrontJob job;
+    pthread_t *threads;
+    int i, j;
+
+    for (i = 0; i <= m; i++) {
+        dp[i][0] = 0; // Initializing first row and column to 0
+        choiceMatrix[i][0] = 0;
+    }
+    for (j = 0; j <= n; j++) {
+        dp[0][j] = 0;
+        choiceMatrix[0][j] = 0;
+    }
+    if (m == 0 || n == 0) return 0;
+    if (tileSize < 1) tileSize = WAVEFRONT_TILE;
+    if (threadCount < 1) threadCount = 1;
+
+    job.X = X;
+    job.Y = Y;
+    job.m = m;
+    job.n = n;
+    job.dp = dp;
+    job.choiceMatrix = choiceMatrix;
+    job.tileSize = tileSize;
+    job.tileRows = (m + tileSize - 1) / tileSize;
+    job.tileCols = (n + tileSize - 1) / tileSize;
+    job.claimed = (atomic_int *)malloc((size_t)(job.tileRows + job.tileCols - 1) * sizeof(atomic_int));
+    for (i = 0; i < job.tileRows + job.tileCols - 1; i++) {
+        atomic_init(&job.claimed[i], 0);
+    }
+    if (threadCount > job.tileRows || threadCount > job.tileCols) {
+        threadCount = job.tileRows < job.tileCols ? job.tileRows : job.tileCols; // no diagonal has more tiles
+    }
+    pthread_barrier_init(&job.barrier, NULL, threadCount);
+
+    threads = (pthread_t *)malloc(threadCount * sizeof(pthread_t));
+    for (i = 1; i < threadCount; i++) {
+        pthread_create(&threads[i], NULL, wavefrontWorker, &job);
+    }
+    wavefrontWorker(&job);
+    for (i = 1; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    pthread_barrier_destroy(&job.barrier);
+    free(job.claimed);
+    return dp[m][n]; // Length of LCS
+}
+
+/*
+    @brief This function returns the number of processors that are online, at least 1.
+    @return the number of online processors
+*/
+int onlineProcessors(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+/*
+    @brief This function checks lcsWavefront against lcs on random pairs (lengths 0 - 300, tile sides 1 - 64, 1 to
+           4 threads) and then fills the matrices of two random ACGT strings of the given length with lcs and with
+           lcsWavefront on 1, 2, 4, ... up to maxThreads threads. Every run is compared cell by cell with lcs.
+    @param length -> the length of the two strings of the timed runs
+    @param tileSize -> the tile side of the timed runs
+    @param maxThreads -> the largest thread count
+    @return
+*/
+void benchmarkWavefront(int length, int tileSize, int maxThreads) {
+    unsigned long long state = 88172645463325252ULL;
+    int mismatches = 0, pair, threads;
+    char *X = (char *)malloc(301), *Y = (char *)malloc(301);
+    int **dp, **choiceMatrix, **wavefrontDP, **wavefrontChoice;
+    double serialTime, oneThreadTime = 0, start;
+    size_t bytes;
+
+    for (pair = 0; pair < 500; pair++) {
+        int m = (int)(state % 301), n;
+        randomString(X, m, pair % 2 ? "ACGT" : "AB", &state);
+        n = (int)(state % 301);
+        randomString(Y, n, pair % 2 ? "ACGT" : "AB", &state);
+        dp = createMatrix(m + 1, n + 1);
+        choiceMatrix = createMatrix(m + 1, n + 1);
+        wavefrontDP = createMatrix(m + 1, n + 1);
+        wavefrontChoice = createMatrix(m + 1, n + 1);
+        lcs(X, Y, m, n, dp, choiceMatrix, 0);
+        lcsWavefront(X, Y, m, n, wavefrontDP, wavefrontChoice, 1 + (int)(state % 64), 1 + pair % 4);
+        bytes = (size_t)(m + 1) * (n + 1) * sizeof(int);
+        mismatches += memcmp(dp[0], wavefrontDP[0], bytes) != 0 || memcmp(choiceMatrix[0], wavefrontChoice[0], bytes) != 0;
+        freeMatrix(dp);
+        freeMatrix(choiceMatrix);
+        freeMatrix(wavefrontDP);
+        freeMatrix(wavefrontChoice);
+    }
+    free(X);
+    free(Y);
+    printf("Cross-check against lcs on 500 random pairs: %d mismatches\n", mismatches);
+
+    if (length < 1) length = 1;
+    if (tileSize < 1) tileSize = WAVEFRONT_TILE;
+    if (maxThreads < 1) maxThreads = 1;
+    X = (char *)malloc((size_t)length + 1);
+    Y = (char *)malloc((size_t)length + 1);
+    randomString(X, length, "ACGT", &state);
+    randomString(Y, length, "ACGT", &state);
+    dp = createMatrix(length + 1, length + 1);
+    choiceMatrix = createMatrix(length + 1, length + 1);
+    wavefrontDP = createMatrix(length + 1, length + 1);
+    wavefrontChoice = createMatrix(length + 1, length + 1);
+    bytes = (size_t)(length + 1) * (length + 1) * sizeof(int);
+
+    memset(dp[0], 0xff, bytes); // touch the pages before the clock starts, like the wavefront runs below
+    memset(choiceMatrix[0], 0xff, bytes);
+    start = getTimeInSeconds();
+    lcs(X, Y, length, length, dp, choiceMatrix, 0);
+    serialTime = getTimeInSeconds() - start;
+    printf("%d x %d, tile %d, %d processors online\n", length, length, tileSize, onlineProcessors());
+    printf("%8s %10s %12s %16s %18s\n", "threads", "seconds", "Mcells/s", "speedup vs lcs", "speedup vs 1 thread");
+    printf("%8s %10.3f %12.0f %16s %18s\n", "lcs", serialTime, (double)length * length / serialTime / 1e6, "1.00", "-");
+
+    for (threads = 1;; threads *= 2) {
+        double seconds;
+        int same;
+        if (threads > maxThreads) threads = maxThreads;
+        memset(wavefrontDP[0], 0xff, bytes); // so a cell that is not written is caught by the check
+        memset(wavefrontChoice[0], 0xff, bytes);
+        start = getTimeInSeconds();
+        lcsWavefront(X, Y, length, length, wavefrontDP, wavefrontChoice, tileSize, threads);
+        seconds = getTimeInSeconds() - start;
+        if (threads == 1) oneThreadTime = seconds;
+        same = memcmp(dp[0], wavefrontDP[0], bytes) == 0 && memcmp(choiceMatrix[0], wavefrontChoice[0], bytes) == 0;
+        printf("%8d %10.3f %12.0f %16.2f %18.2f%s\n", threads, seconds, (double)length * length / seconds / 1e6,
+               serialTime / seconds, oneThreadTime / seconds, same ? "" : "  MISMATCH");
+        if (threads == maxThreads) break;
+    }
+
+    freeMatrix(dp);
+    freeMatrix(choiceMatrix);
+    freeMatrix(wavefrontDP);
+    freeMatrix(wavefrontChoice);
+    free(X);
+    free(Y);
 }
 
 /*
     @brief The main function where the program starts execution.
     @return returns an integer that indicates the exit status of the program, to say the program ended successfully or not
 */
-int main() {
-    char X[MAX], Y[MAX];
+int main(int argc, char *argv[]) {
+    char *X, *Y;
     char choice;
 
+    if (argc == 4 && strcmp(argv[1], "--lcs") == 0) {
+        int m, n, lcsLength;
+        X = readFile(argv[2], &m);
+        Y = readFile(argv[3], &n);
+        if (X == NULL || Y == NULL) {
+            free(X);
+            free(Y);
+            return 1;
+        }
+        char *oneLCS = hirschbergLCS(X, m, Y, n, &lcsLength);
+        printf("%d\n%s\n", lcsLength, oneLCS);
+        free(oneLCS);
+        free(X);
+        free(Y);
+        return 0;
+    }
+    selectLcsKernel(1);
+    if (argc == 4 && strcmp(argv[1], "--lcs-length") == 0) {
+        int m, n;
+        X = readFile(argv[2], &m);
+        Y = readFile(argv[3], &n);
+        if (X == NULL || Y == NULL) {
+            free(X);
+            free(Y);
+            return 1;
+        }
+        printf("%d\n", lcsLengthBitParallel(X, m, Y, n));
+        free(X);
+        free(Y);
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-bitparallel") == 0) {
+        benchmarkBitParallel(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "--bench-hirschberg") == 0) {
+        benchmarkHirschberg(atoi(argv[2]));
+        return 0;
+    }
+    if ((argc == 4 || argc == 5) && strcmp(argv[1], "--all-lcs") == 0) {
+        int m, n;
+        X = readFile(argv[2], &m);
+        Y = readFile(argv[3], &n);
+        if (X == NULL || Y == NULL) {
+            free(X);
+            free(Y);
+            return 1;
+        }
+        if ((long long)(m + 1) * (n + 1) > FULL_MATRIX_LIMIT) {
+            fprintf(stderr, "The files are too long for the full matrices (%d x %d).\n", m, n);
+            free(X);
+            free(Y);
+            return 1;
+        }
+        int **dp = createMatrix(m + 1, n + 1);
+        int **choiceMatrix = createMatrix(m + 1, n + 1);
+        OutputBuffer *output = (OutputBuffer *)malloc(sizeof(OutputBuffer));
+        output->stream = stdout;
+        output->used = 0;
+        lcsWavefront(X, Y, m, n, dp, choiceMatrix, WAVEFRONT_TILE, onlineProcessors());
+        enumerateLCS(dp, X, m, Y, n, argc == 5 ? atoll(argv[4]) : 0, bufferLCS, output);
+        flushOutput(output);
+        free(output);
+        freeMatrix(dp);
+        freeMatrix(choiceMatrix);
+        free(X);
+        free(Y);
+        return 0;
+    }
+    if ((argc == 4 || (argc == 5 && strcmp(argv[4], "exact") == 0)) && strcmp(argv[1], "--count-lcs") == 0) {
+        int m, n, overflow;
+        X = readFile(argv[2], &m);
+        Y = readFile(argv[3], &n);
+        if (X == NULL || Y == NULL) {
+            free(X);
+            free(Y);
+            return 1;
+        }
+        if ((long long)(m + 1) * (n + 1) > FULL_MATRIX_LIMIT) {
+            fprintf(stderr, "The files are too long for the full matrices (%d x %d).\n", m, n);
+            free(X);
+            free(Y);
+            return 1;
+        }
+        int **dp = createMatrix(m + 1, n + 1);
+        int **choiceMatrix = createMatrix(m + 1, n + 1);
+        lcsWavefront(X, Y, m, n, dp, choiceMatrix, WAVEFRONT_TILE, onlineProcessors());
+        if (argc == 5) {
+            char *exactCount = countLCSExact(dp, X, m, Y, n);
+            printf("%s\n", exactCount);
+            free(exactCount);
+        } else {
+            uint64_t lcsCount = countLCS(dp, X, m, Y, n, &overflow);
+            if (overflow) {
+                printf("more than %llu, use exact\n", (unsigned long long)UINT64_MAX);
+            } else {
+                printf("%llu\n", (unsigned long long)lcsCount);
+            }
+        }
+        freeMatrix(dp);
+        freeMatrix(choiceMatrix);
+        free(X);
+        free(Y);
+        return 0;
+    }
+    if (argc >= 3 && argc <= 5 && strcmp(argv[1], "--bench-wavefront") == 0) {
+        benchmarkWavefront(atoi(argv[2]), argc > 3 ? atoi(argv[3]) : WAVEFRONT_TILE, argc > 4 ? atoi(argv[4]) : 32);
+        return 0;
+    }
+    if (argc > 1) {
+        fprintf(stderr, "Usage: %s [--lcs file1 file2 | --lcs-length file1 file2 | --all-lcs file1 file2 [limit]"
+                        " | --count-lcs file1 file2 [exact] | --bench-hirschberg N | --bench-bitparallel N"
+                        " | --bench-wavefront N [tile] [threads]]\n", argv[0]);
+        return 1;
+    }
+
     do {
         printf("Enter String 1: ");
-        scanf("%99s", X);
+        X = readToken();
         printf("Enter String 2: ");
-        scanf("%99s", Y);
+        Y = readToken();
+        if (X == NULL || Y == NULL) {
+            free(X);
+            free(Y);
+            break;
+        }
 
         printAllLCS(X, Y);
+        free(X);
+        free(Y);
 
         choice = getChoice("Do you want to enter another pair of strings? (Y/N): ");
     } while (choice == 'Y' || choice == 'y');